@@ -0,0 +1,212 @@
+#ifndef CHANNEL_HPP
+#define CHANNEL_HPP
+
+#include "linear/queue_circular.hpp"
+
+#include <cassert>
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+template <class E>
+concept Executor =
+  requires(E& executor, std::coroutine_handle<> handle) {
+    executor.schedule(handle);
+  };
+
+// Resumes coroutines right away, on the calling thread.
+struct InlineExecutor {
+  void schedule(std::coroutine_handle<> handle) const {
+    handle.resume();
+  }
+};
+
+// Buffers up to `capacity` values; with capacity zero,
+// every send waits for a matching receive. Waiting
+// coroutines are linked through their own awaiters, so
+// suspending never allocates.
+//
+// Awaiters refer to the channel, so it can be neither
+// copied nor moved, and must not be destroyed while
+// coroutines wait on it: they would never be resumed.
+template <std::movable T, Executor E = InlineExecutor>
+class Channel {
+public:
+  class Sender;
+  class Receiver;
+
+  explicit Channel(std::size_t capacity = 0,
+                   E executor = {});
+  Channel(const Channel&) = delete;
+  auto operator=(const Channel&) -> Channel& = delete;
+  ~Channel() noexcept;
+
+  [[nodiscard]] auto send(T) -> Sender;
+  [[nodiscard]] auto receive() noexcept -> Receiver;
+  [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+private:
+  template <class Waiter>
+  struct Waiters {
+    void push(Waiter*) noexcept;
+    auto pop() noexcept -> Waiter*;
+
+    Waiter* first = nullptr;
+    Waiter* last = nullptr;
+  };
+
+  void resume(std::coroutine_handle<>);
+
+  contiguous::Queue<T> values_;
+  std::size_t size_ = 0;
+  std::size_t capacity_;
+  E executor_;
+  Waiters<Sender> senders_;
+  Waiters<Receiver> receivers_;
+};
+
+template <std::movable T, Executor E>
+class Channel<T, E>::Sender {
+  friend class Channel;
+
+public:
+  auto await_ready() -> bool;
+  void await_suspend(std::coroutine_handle<>) noexcept;
+  void await_resume() const noexcept {}
+
+private:
+  Sender(Channel& channel, T value) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : channel_{channel}, value_{std::move(value)} {}
+
+  Channel& channel_;
+  T value_;
+  std::coroutine_handle<> handle_;
+  Sender* next_ = nullptr;
+};
+
+template <std::movable T, Executor E>
+class Channel<T, E>::Receiver {
+  friend class Channel;
+
+public:
+  auto await_ready() -> bool;
+  void await_suspend(std::coroutine_handle<>) noexcept;
+  auto await_resume() -> T { return std::move(*value_); }
+
+private:
+  explicit Receiver(Channel& channel) noexcept
+    : channel_{channel} {}
+
+  Channel& channel_;
+  std::optional<T> value_;
+  std::coroutine_handle<> handle_;
+  Receiver* next_ = nullptr;
+};
+
+template <std::movable T, Executor E>
+Channel<T, E>::Channel(std::size_t capacity, E executor)
+  : capacity_{capacity}, executor_{std::move(executor)} {}
+
+template <std::movable T, Executor E>
+Channel<T, E>::~Channel() noexcept {
+  assert(senders_.first == nullptr and
+         receivers_.first == nullptr);
+}
+
+template <std::movable T, Executor E>
+auto Channel<T, E>::send(T value) -> Sender {
+  return {*this, std::move(value)};
+}
+
+template <std::movable T, Executor E>
+auto Channel<T, E>::receive() noexcept -> Receiver {
+  return Receiver{*this};
+}
+
+template <std::movable T, Executor E>
+auto Channel<T, E>::is_empty() const noexcept -> bool {
+  return size_ == 0 and senders_.first == nullptr;
+}
+
+template <std::movable T, Executor E>
+void Channel<T, E>::resume(std::coroutine_handle<> handle) {
+  executor_.schedule(handle);
+}
+
+template <std::movable T, Executor E>
+template <class Waiter>
+void Channel<T, E>::Waiters<Waiter>::push(
+  Waiter* waiter) noexcept {
+  if (last)
+    last = last->next_ = waiter;
+  else
+    first = last = waiter;
+}
+
+template <std::movable T, Executor E>
+template <class Waiter>
+auto Channel<T, E>::Waiters<Waiter>::pop() noexcept
+  -> Waiter* {
+  auto waiter = first;
+  if (waiter and not(first = waiter->next_))
+    last = nullptr;
+  return waiter;
+}
+
+template <std::movable T, Executor E>
+auto Channel<T, E>::Sender::await_ready() -> bool {
+  if (auto receiver = channel_.receivers_.pop()) {
+    receiver->value_.emplace(std::move(value_));
+    channel_.resume(receiver->handle_);
+    return true;
+  }
+
+  if (channel_.size_ < channel_.capacity_) {
+    channel_.values_.enqueue(std::move(value_));
+    ++channel_.size_;
+    return true;
+  }
+
+  return false;
+}
+
+template <std::movable T, Executor E>
+void Channel<T, E>::Sender::await_suspend(
+  std::coroutine_handle<> handle) noexcept {
+  handle_ = handle;
+  channel_.senders_.push(this);
+}
+
+template <std::movable T, Executor E>
+auto Channel<T, E>::Receiver::await_ready() -> bool {
+  if (channel_.size_ > 0) {
+    value_.emplace(std::move(channel_.values_.front()));
+    channel_.values_.dequeue();
+    --channel_.size_;
+
+    if (auto sender = channel_.senders_.pop()) {
+      channel_.values_.enqueue(std::move(sender->value_));
+      ++channel_.size_;
+      channel_.resume(sender->handle_);
+    }
+    return true;
+  }
+
+  if (auto sender = channel_.senders_.pop()) {
+    value_.emplace(std::move(sender->value_));
+    channel_.resume(sender->handle_);
+    return true;
+  }
+
+  return false;
+}
+
+template <std::movable T, Executor E>
+void Channel<T, E>::Receiver::await_suspend(
+  std::coroutine_handle<> handle) noexcept {
+  handle_ = handle;
+  channel_.receivers_.push(this);
+}
+
+#endif // CHANNEL_HPP
@@ -1,12 +1,26 @@
 #ifndef COLONY_HPP
 #define COLONY_HPP
 
+#include "linear/hash_index.hpp"
+#include "linear/page_allocator.hpp"
+#include "linear/snapshot.hpp"
+
 #include <memory>
+#include <type_traits>
 #include <utility>
 
-template <std::movable T>
+// With a KeyOf callable, the colony also keeps a hash index
+// of its elements by KeyOf{}(value), which find() looks up.
+// The index is not told when a key changes, so an element's
+// key must not be modified through its pointer; remove the
+// element and insert it again instead.
+template <std::movable T, class KeyOf = void>
 class Colony {
+  static constexpr bool indexed = not std::is_void_v<KeyOf>;
+
 public:
+  using Key = typename IndexKey<T, KeyOf>::type;
+
   Colony(std::size_t capacity = 4);
   ~Colony() noexcept;
 
@@ -14,8 +28,15 @@ public:
   void remove(T*) noexcept;
   auto search(const std::predicate<const T&> auto&)
     const noexcept -> T*;
+  auto find(const Key&) const noexcept -> T*
+    requires indexed;
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   struct Node {
     Node(Node*, Node*, Node*) noexcept;
@@ -31,7 +52,16 @@ private:
     Node* next;
   };
 
-  class Bucket : private std::allocator<Node> {
+  struct NodeKey {
+    auto operator()(const Node& node) const
+      noexcept(noexcept(KeyOf{}(node.value)))
+        -> decltype(auto) {
+      return KeyOf{}(node.value);
+    }
+  };
+  struct NoIndex {};
+
+  class Bucket : private PageAllocator<Node> {
   public:
     explicit Bucket(std::size_t capacity);
     explicit Bucket(Bucket* previous);
@@ -52,73 +82,86 @@ private:
 
   Bucket* last_bucket_;
   Node head_ = {nullptr, &head_, &head_};
+  [[no_unique_address]] std::conditional_t<
+    indexed, HashIndex<Node, NodeKey>, NoIndex> index_;
 };
 
-template <std::movable T>
-Colony<T>::Colony(std::size_t capacity)
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Colony(std::size_t capacity)
   : last_bucket_{new Bucket(capacity)} {}
 
-template <std::movable T>
-Colony<T>::Node::Node(Node* last_removed, Node* previous,
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Node::Node(Node* last_removed, Node* previous,
                       Node* next) noexcept
   : last_removed{last_removed},
     next{next},
     previous{previous} {}
 
-template <std::movable T>
-Colony<T>::Node::Node(T value, Node* previous,
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Node::Node(T value, Node* previous,
                       Node* next)
   : value{std::move(value)},
     next{next},
     previous{previous} {}
 
-template <std::movable T>
-Colony<T>::Bucket::Bucket(std::size_t capacity)
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Bucket::Bucket(std::size_t capacity)
   : capacity_{capacity < 4 ? 4 : capacity} {}
 
-template <std::movable T>
-Colony<T>::Bucket::Bucket(Bucket* previous)
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Bucket::Bucket(Bucket* previous)
   : capacity_{2 * previous->capacity_},
     previous{std::move(previous)} {}
 
-template <std::movable T>
-Colony<T>::Bucket::~Bucket() noexcept {
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::Bucket::~Bucket() noexcept {
   delete previous;
   this->deallocate(nodes_, capacity_);
 }
 
-template <std::movable T>
-auto Colony<T>::Bucket::full() const noexcept -> bool {
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::Bucket::full() const noexcept
+  -> bool {
   return size_ == capacity_;
 }
 
-template <std::movable T>
-auto Colony<T>::Bucket::insert(T value, Node* prev,
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::Bucket::insert(T value, Node* prev,
                                Node* next) -> Node* {
   return new (nodes_ + size_++)
     Node(std::move(value), prev, next);
 }
 
-template <std::movable T>
-Colony<T>::~Colony() noexcept {
+template <std::movable T, class KeyOf>
+Colony<T, KeyOf>::~Colony() noexcept {
   for (auto node = head_.next; node != &head_;)
     std::destroy_at(
       &std::exchange(node, node->next)->value);
   delete last_bucket_;
 }
 
-template <std::movable T>
-auto Colony<T>::insert(T value) -> T* {
-  if (head_.last_removed)
-    return insert_at_last_removed(std::move(value));
-  return insert_at_end(std::move(value));
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::insert(T value) -> T* {
+  if constexpr (indexed)
+    index_.reserve(index_.size() + 1);
+
+  auto ptr = head_.last_removed
+               ? insert_at_last_removed(std::move(value))
+               : insert_at_end(std::move(value));
+
+  if constexpr (indexed)
+    index_.insert(reinterpret_cast<Node*>(ptr));
+
+  return ptr;
 }
 
-template <std::movable T>
-void Colony<T>::remove(T* ptr) noexcept {
+template <std::movable T, class KeyOf>
+void Colony<T, KeyOf>::remove(T* ptr) noexcept {
   Node* to_be_removed = reinterpret_cast<Node*>(ptr);
   auto previous = to_be_removed->previous;
 
+  if constexpr (indexed)
+    index_.erase(to_be_removed);
   std::destroy_at(&to_be_removed->value);
   to_be_removed->last_removed = head_.last_removed;
 
@@ -127,8 +170,8 @@ void Colony<T>::remove(T* ptr) noexcept {
   head_.last_removed = to_be_removed;
 }
 
-template <std::movable T>
-auto Colony<T>::search(
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::search(
   const std::predicate<const T&> auto& f) const noexcept
   -> T* {
   for (auto node = head_.next; node != &head_;
@@ -138,13 +181,43 @@ auto Colony<T>::search(
   return nullptr;
 }
 
-template <std::movable T>
-auto Colony<T>::is_empty() const noexcept -> bool {
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::find(const Key& key) const noexcept
+  -> T*
+  requires indexed {
+  auto node = index_.find(key);
+  return node ? &node->value : nullptr;
+}
+
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::is_empty() const noexcept -> bool {
   return head_.next == &head_;
 }
 
-template <std::movable T>
-auto Colony<T>::insert_at_end(T value) -> T* {
+template <std::movable T, class KeyOf>
+void Colony<T, KeyOf>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  std::size_t count = 0;
+  for (auto node = head_.next; node != &head_;
+       node = node->next)
+    ++count;
+
+  write_header<T>(writer, count);
+  for (auto node = head_.next; node != &head_;
+       node = node->next)
+    write_element(writer, node->value);
+}
+
+template <std::movable T, class KeyOf>
+void Colony<T, KeyOf>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  for (auto count = read_header<T>(reader);
+       count > 0; --count)
+    insert(read_element<T>(reader));
+}
+
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::insert_at_end(T value) -> T* {
   if (last_bucket_->full())
     last_bucket_ = new Bucket(std::move(last_bucket_));
 
@@ -157,8 +230,8 @@ auto Colony<T>::insert_at_end(T value) -> T* {
   return &node->value;
 }
 
-template <std::movable T>
-auto Colony<T>::insert_at_last_removed(T value)
+template <std::movable T, class KeyOf>
+auto Colony<T, KeyOf>::insert_at_last_removed(T value)
   -> T* {
   auto node = head_.last_removed;
   auto next_free = node->last_removed;
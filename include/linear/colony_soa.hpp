@@ -0,0 +1,310 @@
+#ifndef COLONY_SOA_HPP
+#define COLONY_SOA_HPP
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+concept Aggregate =
+  std::is_aggregate_v<T> and std::default_initializable<T>;
+
+// Converts to any field type, to count the fields of an
+// aggregate by the most initialisers it accepts. Array
+// fields count once per element.
+struct AnyField {
+  template <class U>
+  operator U() const;
+};
+
+template <class T, class... Fields>
+constexpr auto field_count() noexcept -> std::size_t {
+  if constexpr (requires { T{Fields{}..., AnyField{}}; })
+    return field_count<T, Fields..., AnyField>();
+  else
+    return sizeof...(Fields);
+}
+
+template <class M, class T>
+concept MemberOf =
+  std::is_member_object_pointer_v<M> and
+  requires(T& value, M member) { value.*member; };
+
+// Colony that stores each member of an aggregate in its
+// own array, so passes over a few members only stream
+// those columns. Every member must be listed once, so that
+// value() returns the element whole.
+template <Aggregate T, MemberOf<T> auto... Members>
+class SoaColony {
+  template <auto Member>
+  using Field = std::remove_cvref_t<
+    decltype(std::declval<T&>().*Member)>;
+
+  class Bucket;
+
+public:
+  class Handle {
+    friend class SoaColony;
+
+  public:
+    Handle() noexcept = default;
+
+  private:
+    Handle(Bucket* bucket, std::size_t index) noexcept
+      : bucket_{bucket}, index_{index} {}
+
+    Bucket* bucket_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  explicit SoaColony(std::size_t capacity = 4);
+  ~SoaColony() noexcept;
+
+  auto insert(T) -> Handle;
+  void remove(Handle) noexcept;
+
+  [[nodiscard]] auto value(Handle) const -> T;
+  template <auto Member>
+  [[nodiscard]] auto get(Handle) noexcept -> Field<Member>&;
+  template <auto Member>
+  [[nodiscard]] auto get(Handle) const noexcept
+    -> const Field<Member>&;
+
+  template <auto... Selected>
+  void for_each(auto&& f);
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+private:
+  class Bucket {
+  public:
+    explicit Bucket(std::size_t capacity);
+    explicit Bucket(Bucket* previous);
+    ~Bucket() noexcept;
+
+    auto full() const noexcept -> bool;
+    void destroy(std::size_t) noexcept;
+
+    std::size_t capacity_;
+    Bucket* previous_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t holes_ = 0;
+    bool* alive_;
+    Handle* next_free_;
+    std::tuple<Field<Members>*...> columns_;
+  };
+
+  template <auto A, auto B>
+  static constexpr auto is_same_member() noexcept -> bool;
+  template <auto Member>
+  static constexpr auto column() noexcept -> std::size_t;
+  static constexpr auto is_distinct() noexcept -> bool;
+
+  static_assert(sizeof...(Members) == field_count<T>(),
+                "every member of T must be listed");
+  static_assert(is_distinct(),
+                "each member of T must be listed once");
+
+  Bucket* last_bucket_;
+  Handle last_removed_;
+  std::size_t size_ = 0;
+};
+
+template <Aggregate T, MemberOf<T> auto... Members>
+SoaColony<T, Members...>::SoaColony(std::size_t capacity)
+  : last_bucket_{new Bucket(capacity)} {}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+SoaColony<T, Members...>::~SoaColony() noexcept {
+  for (auto bucket = last_bucket_; bucket;
+       bucket = bucket->previous_)
+    for (std::size_t i = 0; i < bucket->size_; ++i)
+      if (bucket->alive_[i])
+        bucket->destroy(i);
+  delete last_bucket_;
+}
+
+// The slot is only claimed once every column is built, so
+// that a throwing member leaves the colony unchanged.
+template <Aggregate T, MemberOf<T> auto... Members>
+auto SoaColony<T, Members...>::insert(T value) -> Handle {
+  if (not last_removed_.bucket_ and last_bucket_->full())
+    last_bucket_ = new Bucket(last_bucket_);
+  auto reuse = last_removed_.bucket_ != nullptr;
+  auto handle = reuse ? last_removed_
+                      : Handle{last_bucket_,
+                               last_bucket_->size_};
+
+  auto bucket = handle.bucket_;
+  auto index = handle.index_;
+  std::apply(
+    [&](auto*... column) {
+      std::size_t built = 0;
+      try {
+        ((std::construct_at(column + index,
+                            std::move(value.*Members)),
+          ++built),
+         ...);
+      } catch (...) {
+        std::size_t i = 0;
+        ((i++ < built ? std::destroy_at(column + index)
+                      : void()),
+         ...);
+        throw;
+      }
+    },
+    bucket->columns_);
+
+  if (reuse) {
+    last_removed_ = bucket->next_free_[index];
+    --bucket->holes_;
+  } else {
+    ++bucket->size_;
+  }
+  bucket->alive_[index] = true;
+  ++size_;
+
+  return handle;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+void SoaColony<T, Members...>::remove(
+  Handle handle) noexcept {
+  handle.bucket_->destroy(handle.index_);
+  handle.bucket_->alive_[handle.index_] = false;
+  handle.bucket_->next_free_[handle.index_] =
+    last_removed_;
+  ++handle.bucket_->holes_;
+  last_removed_ = handle;
+  --size_;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+auto SoaColony<T, Members...>::value(Handle handle) const
+  -> T {
+  T value{};
+  ((value.*Members = get<Members>(handle)), ...);
+  return value;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+template <auto Member>
+auto SoaColony<T, Members...>::get(Handle handle) noexcept
+  -> Field<Member>& {
+  return std::get<column<Member>()>(
+    handle.bucket_->columns_)[handle.index_];
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+template <auto Member>
+auto SoaColony<T, Members...>::get(
+  Handle handle) const noexcept -> const Field<Member>& {
+  return std::get<column<Member>()>(
+    handle.bucket_->columns_)[handle.index_];
+}
+
+// Calls f with the selected members of every element. Only
+// the selected columns are read, and buckets without holes
+// run a branch-free loop the compiler can vectorise.
+template <Aggregate T, MemberOf<T> auto... Members>
+template <auto... Selected>
+void SoaColony<T, Members...>::for_each(auto&& f) {
+  for (auto bucket = last_bucket_; bucket;
+       bucket = bucket->previous_)
+    [&, alive = bucket->alive_, size = bucket->size_,
+     dense = bucket->holes_ == 0](
+      auto* __restrict... columns) {
+      if (dense)
+        for (std::size_t i = 0; i < size; ++i)
+          f(columns[i]...);
+      else
+        for (std::size_t i = 0; i < size; ++i)
+          if (alive[i])
+            f(columns[i]...);
+    }(std::get<column<Selected>()>(bucket->columns_)...);
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+auto SoaColony<T, Members...>::is_empty() const noexcept
+  -> bool {
+  return size_ == 0;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+SoaColony<T, Members...>::Bucket::Bucket(
+  std::size_t capacity)
+  : capacity_{capacity < 4 ? 4 : capacity},
+    alive_{std::allocator<bool>{}.allocate(capacity_)},
+    next_free_{std::allocator<Handle>{}.allocate(capacity_)},
+    columns_{std::allocator<Field<Members>>{}.allocate(
+      capacity_)...} {
+  std::uninitialized_fill_n(alive_, capacity_, false);
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+SoaColony<T, Members...>::Bucket::Bucket(Bucket* previous)
+  : Bucket(2 * previous->capacity_) {
+  previous_ = previous;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+SoaColony<T, Members...>::Bucket::~Bucket() noexcept {
+  delete previous_;
+  std::apply(
+    [&](auto*... column) {
+      (std::allocator<std::remove_pointer_t<
+         decltype(column)>>{}
+         .deallocate(column, capacity_),
+       ...);
+    },
+    columns_);
+  std::allocator<Handle>{}.deallocate(next_free_,
+                                      capacity_);
+  std::allocator<bool>{}.deallocate(alive_, capacity_);
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+auto SoaColony<T, Members...>::Bucket::full() const noexcept
+  -> bool {
+  return size_ == capacity_;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+void SoaColony<T, Members...>::Bucket::destroy(
+  std::size_t index) noexcept {
+  std::apply(
+    [&](auto*... column) {
+      (std::destroy_at(column + index), ...);
+    },
+    columns_);
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+template <auto A, auto B>
+constexpr auto
+SoaColony<T, Members...>::is_same_member() noexcept -> bool {
+  if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+    return A == B;
+  else
+    return false;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+template <auto Member>
+constexpr auto SoaColony<T, Members...>::column() noexcept
+  -> std::size_t {
+  std::size_t i = 0;
+  (... and (is_same_member<Members, Member>() ? false
+                                             : (++i, true)));
+  return i;
+}
+
+template <Aggregate T, MemberOf<T> auto... Members>
+constexpr auto
+SoaColony<T, Members...>::is_distinct() noexcept -> bool {
+  std::size_t i = 0;
+  return (... and (column<Members>() == i++));
+}
+
+#endif // COLONY_SOA_HPP
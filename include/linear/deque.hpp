@@ -1,7 +1,13 @@
 #ifndef DEQUE_DOUBLE_LINKED_CIRCULAR_HPP
 #define DEQUE_DOUBLE_LINKED_CIRCULAR_HPP
 
+#include "linear/snapshot.hpp"
+
+#include <cassert>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 template <std::movable T>
@@ -20,6 +26,26 @@ public:
 
   auto is_empty() const noexcept -> bool;
 
+  auto try_remove_front() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  auto try_remove_rear() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  auto remove_front_value() -> T;
+  auto remove_rear_value() -> T;
+
+  // Expect a non-empty deque, checked only by assert.
+  auto unchecked_front() const noexcept -> const T&;
+  auto unchecked_rear() const noexcept -> const T&;
+  void unchecked_remove_front() noexcept;
+  void unchecked_remove_rear() noexcept;
+
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   struct Node {
     ~Node() noexcept {}
@@ -62,31 +88,28 @@ template <std::movable T>
 void Deque<T>::remove_front() {
   if (is_empty())
     throw std::runtime_error{"empty deque has no front"};
-  head_.next->next->previous = &head_;
-  Node::erase(std::exchange(head_.next, head_.next->next));
+  unchecked_remove_front();
 }
 
 template <std::movable T>
 void Deque<T>::remove_rear() {
   if (is_empty())
     throw std::runtime_error{"empty deque has no rear"};
-  head_.previous->previous->next = &head_;
-  Node::erase(std::exchange(head_.previous,
-                            head_.previous->previous));
+  unchecked_remove_rear();
 }
 
 template <std::movable T>
 auto Deque<T>::front() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty deque has no front"};
-  return head_.next->value;
+  return unchecked_front();
 }
 
 template <std::movable T>
 auto Deque<T>::rear() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty deque has no rear"};
-  return head_.previous->value;
+  return unchecked_rear();
 }
 
 template <std::movable T>
@@ -94,6 +117,95 @@ auto Deque<T>::is_empty() const noexcept -> bool {
   return head_.next == &head_;
 }
 
+template <std::movable T>
+auto Deque<T>::try_remove_front() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(head_.next->value)};
+  unchecked_remove_front();
+  return value;
+}
+
+template <std::movable T>
+auto Deque<T>::try_remove_rear() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(head_.previous->value)};
+  unchecked_remove_rear();
+  return value;
+}
+
+template <std::movable T>
+auto Deque<T>::remove_front_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"empty deque has no front"};
+  auto value = std::move(head_.next->value);
+  unchecked_remove_front();
+  return value;
+}
+
+template <std::movable T>
+auto Deque<T>::remove_rear_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"empty deque has no rear"};
+  auto value = std::move(head_.previous->value);
+  unchecked_remove_rear();
+  return value;
+}
+
+template <std::movable T>
+auto Deque<T>::unchecked_front() const noexcept
+  -> const T& {
+  assert(not is_empty());
+  return head_.next->value;
+}
+
+template <std::movable T>
+auto Deque<T>::unchecked_rear() const noexcept
+  -> const T& {
+  assert(not is_empty());
+  return head_.previous->value;
+}
+
+template <std::movable T>
+void Deque<T>::unchecked_remove_front() noexcept {
+  assert(not is_empty());
+  head_.next->next->previous = &head_;
+  Node::erase(std::exchange(head_.next, head_.next->next));
+}
+
+template <std::movable T>
+void Deque<T>::unchecked_remove_rear() noexcept {
+  assert(not is_empty());
+  head_.previous->previous->next = &head_;
+  Node::erase(std::exchange(head_.previous,
+                            head_.previous->previous));
+}
+
+template <std::movable T>
+void Deque<T>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  std::size_t count = 0;
+  for (auto p = head_.next; p != &head_; p = p->next)
+    ++count;
+
+  write_header<T>(writer, count);
+  for (auto p = head_.next; p != &head_; p = p->next)
+    write_element(writer, p->value);
+}
+
+template <std::movable T>
+void Deque<T>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  for (auto count = read_header<T>(reader);
+       count > 0; --count)
+    insert_rear(read_element<T>(reader));
+}
+
 template <std::movable T>
 auto Deque<T>::Node::make(T value, Node* prev, Node* next)
   -> Node* {
@@ -0,0 +1,193 @@
+#ifndef HASH_INDEX_HPP
+#define HASH_INDEX_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Open-addressing table of node pointers, looked up by
+// KeyOf{}(node). Probing is linear and erasing shifts the
+// following entries back, so there are no tombstones.
+//
+// KeyOf runs on every probe of the noexcept lookups and
+// erasures, so it must not throw, and must return either a
+// reference or a trivially copyable key: copying a string
+// per probe could throw, and would slow every lookup.
+template <class Node, class KeyOf>
+class HashIndex : private std::allocator<Node*> {
+  using Result = std::invoke_result_t<KeyOf, const Node&>;
+
+public:
+  using Key = std::remove_cvref_t<Result>;
+
+  static_assert(
+    std::is_nothrow_invocable_v<KeyOf, const Node&> and
+      (std::is_reference_v<Result> or
+       std::is_trivially_copyable_v<Key>),
+    "KeyOf must be noexcept and return a reference or a "
+    "trivially copyable key");
+
+  HashIndex() noexcept = default;
+  HashIndex(HashIndex&&) noexcept;
+  ~HashIndex() noexcept;
+
+  void insert(Node*);
+  void erase(Node*) noexcept;
+  [[nodiscard]] auto find(const Key&) const noexcept
+    -> Node*;
+
+  void reserve(std::size_t);
+  void clear() noexcept;
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+  auto slot(const Key&) const noexcept -> std::size_t;
+  auto next(std::size_t) const noexcept -> std::size_t;
+  void rehash(std::size_t);
+
+  static auto key(const Node* node) noexcept
+    -> decltype(auto) {
+    return KeyOf{}(*node);
+  }
+
+  Node** slots_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+  int shift_ = 64;
+};
+
+template <class Node, class KeyOf>
+HashIndex<Node, KeyOf>::HashIndex(
+  HashIndex&& other) noexcept
+  : slots_{std::exchange(other.slots_, nullptr)},
+    capacity_{std::exchange(other.capacity_, 0)},
+    size_{std::exchange(other.size_, 0)},
+    shift_{std::exchange(other.shift_, 64)} {}
+
+template <class Node, class KeyOf>
+HashIndex<Node, KeyOf>::~HashIndex() noexcept {
+  this->deallocate(slots_, capacity_);
+}
+
+template <class Node, class KeyOf>
+void HashIndex<Node, KeyOf>::insert(Node* node) {
+  reserve(size_ + 1);
+
+  auto i = slot(key(node));
+  while (slots_[i])
+    i = next(i);
+
+  slots_[i] = node;
+  ++size_;
+}
+
+template <class Node, class KeyOf>
+void HashIndex<Node, KeyOf>::erase(Node* node) noexcept {
+  auto i = slot(key(node));
+  while (slots_[i] != node)
+    i = next(i);
+
+  // Pull back every entry whose probe sequence passes
+  // through the hole, until an empty slot ends the run.
+  for (auto j = next(i); slots_[j]; j = next(j)) {
+    auto home = slot(key(slots_[j]));
+    auto stays = i <= j ? i < home and home <= j
+                        : i < home or home <= j;
+    if (not stays) {
+      slots_[i] = slots_[j];
+      i = j;
+    }
+  }
+
+  slots_[i] = nullptr;
+  --size_;
+}
+
+template <class Node, class KeyOf>
+auto HashIndex<Node, KeyOf>::find(
+  const Key& k) const noexcept -> Node* {
+  if (size_ == 0)
+    return nullptr;
+
+  for (auto i = slot(k); slots_[i]; i = next(i))
+    if (key(slots_[i]) == k)
+      return slots_[i];
+  return nullptr;
+}
+
+// Makes room for n entries, so the following inserts up to
+// n do not allocate.
+template <class Node, class KeyOf>
+void HashIndex<Node, KeyOf>::reserve(std::size_t n) {
+  if (2 * n > capacity_)
+    rehash(std::max<std::size_t>(8, std::bit_ceil(2 * n)));
+}
+
+template <class Node, class KeyOf>
+void HashIndex<Node, KeyOf>::clear() noexcept {
+  std::fill_n(slots_, capacity_, nullptr);
+  size_ = 0;
+}
+
+template <class Node, class KeyOf>
+auto HashIndex<Node, KeyOf>::size() const noexcept
+  -> std::size_t {
+  return size_;
+}
+
+// Fibonacci hashing spreads the bits of weak hashes, such
+// as the identity hash of integers, over the whole table.
+template <class Node, class KeyOf>
+auto HashIndex<Node, KeyOf>::slot(
+  const Key& k) const noexcept -> std::size_t {
+  std::uint64_t h = std::hash<Key>{}(k);
+  return (h * 0x9E3779B97F4A7C15ull) >> shift_;
+}
+
+template <class Node, class KeyOf>
+auto HashIndex<Node, KeyOf>::next(
+  std::size_t i) const noexcept -> std::size_t {
+  return (i + 1) & (capacity_ - 1);
+}
+
+template <class Node, class KeyOf>
+void HashIndex<Node, KeyOf>::rehash(
+  std::size_t new_capacity) {
+  auto old_slots = std::exchange(
+    slots_, this->allocate(new_capacity));
+  auto old_capacity =
+    std::exchange(capacity_, new_capacity);
+
+  shift_ = 64 - std::countr_zero(new_capacity);
+  std::uninitialized_fill_n(slots_, capacity_, nullptr);
+
+  for (std::size_t i = 0; i < old_capacity; ++i)
+    if (old_slots[i]) {
+      auto j = slot(key(old_slots[i]));
+      while (slots_[j])
+        j = next(j);
+      slots_[j] = old_slots[i];
+    }
+
+  this->deallocate(old_slots, old_capacity);
+}
+
+// Type of KeyOf{}(value), for containers whose index is
+// optional. Without a KeyOf it is an empty type, so that
+// they can still declare find(const Key&).
+template <class T, class KeyOf>
+struct IndexKey {
+  using type = std::remove_cvref_t<
+    std::invoke_result_t<KeyOf, const T&>>;
+};
+
+template <class T>
+struct IndexKey<T, void> {
+  struct type {};
+};
+
+#endif // HASH_INDEX_HPP
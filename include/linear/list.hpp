@@ -1,12 +1,27 @@
 #ifndef LINKED_LIST_HPP
 #define LINKED_LIST_HPP
 
+#include "linear/hash_index.hpp"
+#include "linear/snapshot.hpp"
+
+#include <cassert>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template <std::movable T>
+// With a KeyOf callable, the list also keeps a hash index
+// of its nodes by KeyOf{}(value), which find() looks up.
+// The index is not told when a key changes, so an element's
+// key must not be modified through value(); remove the
+// element and insert it again instead.
+template <std::movable T, class KeyOf = void>
 class List {
+  static constexpr bool indexed = not std::is_void_v<KeyOf>;
+
 public:
+  using Key = typename IndexKey<T, KeyOf>::type;
+
   class Node {
     friend class List;
 
@@ -29,6 +44,8 @@ public:
     };
   };
 
+  List() noexcept = default;
+  List(List&&) noexcept;
   ~List() noexcept;
 
   [[nodiscard]] auto before_first() noexcept -> Node*;
@@ -37,68 +54,128 @@ public:
   auto search(const std::predicate<const T&> auto& f) const
     noexcept(noexcept(f(std::declval<const T&>())))
       -> Node*;
+  auto find(const Key&) const noexcept -> Node*
+    requires indexed;
 
   auto insert_after(Node*, T) -> Node*;
   void remove_after(Node*);
+  auto try_remove_after(Node*) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  auto remove_after_value(Node*) -> T;
 
-  auto graft_after(Node*, List&) noexcept -> Node*;
-  auto extract_between(Node*, Node*) noexcept -> List;
+  // Expects a node after the position, checked only by
+  // assert.
+  void unchecked_remove_after(Node*) noexcept;
 
-  auto concatenate(List&) noexcept -> Node*;
-  auto split_after(Node*) noexcept -> List;
+  // Indexed lists may rehash, and so throw, when splicing.
+  auto graft_after(Node*, List&) noexcept(not indexed)
+    -> Node*;
+  auto extract_between(Node*, Node*) noexcept(not indexed)
+    -> List;
+
+  auto concatenate(List&) noexcept(not indexed) -> Node*;
+  auto split_after(Node*) noexcept(not indexed) -> List;
 
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
+  struct NodeKey {
+    auto operator()(const Node& node) const
+      noexcept(noexcept(KeyOf{}(node.value_)))
+        -> decltype(auto) {
+      return KeyOf{}(node.value_);
+    }
+  };
+  struct NoIndex {};
+
+  auto unlink_after(Node*) noexcept -> Node*;
+  void move_to_index(Node* first, Node* last,
+                     List& from) noexcept(not indexed);
+
   Node head_;
   Node* last_ = &head_;
+  [[no_unique_address]] std::conditional_t<
+    indexed, HashIndex<Node, NodeKey>, NoIndex> index_;
 };
 
-template <std::movable T>
-List<T>::Node::Node(Node* next, T value) noexcept
+template <std::movable T, class KeyOf>
+List<T, KeyOf>::Node::Node(Node* next, T value) noexcept
   : next_{next}, value_{std::move(value)} {}
 
-template <std::movable T>
-auto List<T>::Node::make(T value, Node* next) -> Node* {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::Node::make(T value, Node* next)
+  -> Node* {
   return new Node(next, std::move(value));
 }
 
-template <std::movable T>
-void List<T>::Node::erase(Node* node) noexcept {
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::Node::erase(Node* node) noexcept {
   node->value_.~T();
   delete node;
 }
 
-template <std::movable T>
-List<T>::~List() noexcept {
+template <std::movable T, class KeyOf>
+List<T, KeyOf>::List(List&& list) noexcept
+  : index_{std::move(list.index_)} {
+  if (list.is_empty())
+    return;
+
+  head_.next_ = std::exchange(list.head_.next_, nullptr);
+  last_ = std::exchange(list.last_, &list.head_);
+}
+
+template <std::movable T, class KeyOf>
+List<T, KeyOf>::~List() noexcept {
   for (auto p = head_.next(); p != nullptr;)
     Node::erase(std::exchange(p, p->next()));
 }
 
-template <std::movable T>
-auto List<T>::before_first() noexcept -> Node* {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::before_first() noexcept -> Node* {
   return &head_;
 }
 
-template <std::movable T>
-auto List<T>::last() noexcept -> Node* {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::last() noexcept -> Node* {
   return last_;
 }
 
-template <std::movable T>
-auto List<T>::search(
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::search(
   const std::predicate<const T&> auto& f) const
   noexcept(noexcept(f(std::declval<const T&>()))) -> Node* {
-  for (auto p = head_.next(); p != nullptr;)
-    if (f(p->value()))
+  for (auto p = head_.next_; p != nullptr; p = p->next_)
+    if (f(static_cast<const T&>(p->value_)))
       return p;
   return nullptr;
 }
 
-template <std::movable T>
-auto List<T>::insert_after(Node* prev, T value) -> Node* {
-  auto node = prev->next_ =
-    Node::make(std::move(value), prev->next_);
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::find(const Key& key) const noexcept
+  -> Node*
+  requires indexed {
+  return index_.find(key);
+}
+
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::insert_after(Node* prev, T value)
+  -> Node* {
+  auto node = Node::make(std::move(value), prev->next_);
+
+  if constexpr (indexed) try {
+    index_.insert(node);
+  } catch (...) {
+    Node::erase(node);
+    throw;
+  }
+
+  prev->next_ = node;
 
   if (node->next_ == nullptr)
     last_ = node;
@@ -106,23 +183,66 @@ auto List<T>::insert_after(Node* prev, T value) -> Node* {
   return node;
 }
 
-template <std::movable T>
-void List<T>::remove_after(Node* prev) {
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::remove_after(Node* prev) {
   if (prev->next_ == nullptr)
     throw std::runtime_error{"cannot remove past end"};
+  unchecked_remove_after(prev);
+}
 
-  delete std::exchange(prev->next_, prev->next_->next_);
+// Here and in remove_after_value, the node leaves the
+// index before its value is moved out, since the index
+// hashes the value.
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::try_remove_after(Node* prev) noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (prev->next_ == nullptr)
+    return std::nullopt;
+  auto node = unlink_after(prev);
+  std::optional<T> value{std::move(node->value_)};
+  Node::erase(node);
+  return value;
+}
 
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::remove_after_value(Node* prev) -> T {
   if (prev->next_ == nullptr)
-    last_ = prev;
+    throw std::runtime_error{"cannot remove past end"};
+  auto node = unlink_after(prev);
+  auto value = std::move(node->value_);
+  Node::erase(node);
+  return value;
+}
+
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::unchecked_remove_after(
+  Node* prev) noexcept {
+  assert(prev->next_ != nullptr);
+  Node::erase(unlink_after(prev));
 }
 
-template <std::movable T>
-auto List<T>::graft_after(Node* prev, List& list) noexcept
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::unlink_after(Node* prev) noexcept
   -> Node* {
+  if constexpr (indexed)
+    index_.erase(prev->next_);
+  auto node =
+    std::exchange(prev->next_, prev->next_->next_);
+
+  if (prev->next_ == nullptr)
+    last_ = prev;
+  return node;
+}
+
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::graft_after(Node* prev, List& list)
+  noexcept(not indexed) -> Node* {
   if (list.is_empty())
     return prev;
 
+  move_to_index(list.head_.next_, list.last_, list);
+
   auto next = list.last_->next_ = prev->next_;
   prev->next_ = list.head_.next_;
 
@@ -136,13 +256,14 @@ auto List<T>::graft_after(Node* prev, List& list) noexcept
 }
 
 // (previous, last]
-template <std::movable T>
-auto List<T>::extract_between(Node* prev,
-                              Node* last) noexcept -> List {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::extract_between(Node* prev, Node* last)
+  noexcept(not indexed) -> List {
   if (prev == last or prev->next_ == nullptr)
     return {};
 
   List list;
+  list.move_to_index(prev->next_, last, *this);
 
   list.head_.next_ = prev->next_;
   list.last_ = last;
@@ -156,11 +277,14 @@ auto List<T>::extract_between(Node* prev,
   return list;
 }
 
-template <std::movable T>
-auto List<T>::concatenate(List& list) noexcept -> Node* {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::concatenate(List& list)
+  noexcept(not indexed) -> Node* {
   if (list.is_empty())
     return last_;
 
+  move_to_index(list.head_.next_, list.last_, list);
+
   last_->next_ = list.head_.next_;
   last_ = list.last_;
 
@@ -170,12 +294,14 @@ auto List<T>::concatenate(List& list) noexcept -> Node* {
   return last_;
 }
 
-template <std::movable T>
-auto List<T>::split_after(Node* prev) noexcept -> List {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::split_after(Node* prev)
+  noexcept(not indexed) -> List {
   if (prev->next_ == nullptr)
     return {};
 
   List list;
+  list.move_to_index(prev->next_, last_, *this);
 
   list.head_.next_ = prev->next_;
   list.last_ = last_;
@@ -186,9 +312,50 @@ auto List<T>::split_after(Node* prev) noexcept -> List {
   return list;
 }
 
-template <std::movable T>
-auto List<T>::is_empty() const noexcept -> bool {
+template <std::movable T, class KeyOf>
+auto List<T, KeyOf>::is_empty() const noexcept -> bool {
   return last_ == &head_;
 }
 
+// Moves the index entries of [first, last] from another
+// list into this one; nothing changes if that throws.
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::move_to_index(Node* first, Node* last,
+                                   List& from)
+  noexcept(not indexed) {
+  if constexpr (indexed) {
+    std::size_t count = 1;
+    for (auto p = first; p != last; p = p->next_)
+      ++count;
+
+    index_.reserve(index_.size() + count);
+    for (auto p = first;; p = p->next_) {
+      from.index_.erase(p);
+      index_.insert(p);
+      if (p == last)
+        break;
+    }
+  }
+}
+
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  std::size_t count = 0;
+  for (auto p = head_.next_; p; p = p->next_)
+    ++count;
+
+  write_header<T>(writer, count);
+  for (auto p = head_.next_; p; p = p->next_)
+    write_element(writer, p->value_);
+}
+
+template <std::movable T, class KeyOf>
+void List<T, KeyOf>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  for (auto count = read_header<T>(reader);
+       count > 0; --count)
+    insert_after(last_, read_element<T>(reader));
+}
+
 #endif // LINKED_LIST_HPP
@@ -0,0 +1,183 @@
+#ifndef LINKED_LIST_INTRUSIVE_HPP
+#define LINKED_LIST_INTRUSIVE_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+// Links objects owned elsewhere through their own `Next`
+// member; positions are element pointers, with nullptr
+// standing for the position before the first element.
+template <class T, T* T::*Next>
+class IntrusiveList {
+public:
+  [[nodiscard]] auto before_first() const noexcept -> T*;
+  [[nodiscard]] auto last() const noexcept -> T*;
+  [[nodiscard]] auto next(T*) const noexcept -> T*;
+
+  auto search(const std::predicate<const T&> auto& f) const
+    noexcept(noexcept(f(std::declval<const T&>()))) -> T*;
+
+  auto insert_after(T*, T&) noexcept -> T*;
+  auto remove_after(T*) -> T*;
+  // Returns nullptr when there is nothing to remove.
+  auto try_remove_after(T*) noexcept -> T*;
+  // Expects an element after the position, checked only by
+  // assert.
+  auto unchecked_remove_after(T*) noexcept -> T*;
+
+  auto graft_after(T*, IntrusiveList&) noexcept -> T*;
+  auto extract_between(T*, T*) noexcept -> IntrusiveList;
+
+  auto concatenate(IntrusiveList&) noexcept -> T*;
+  auto split_after(T*) noexcept -> IntrusiveList;
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+private:
+  auto link(T*) noexcept -> T*&;
+
+  T* first_ = nullptr;
+  T* last_ = nullptr;
+};
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::before_first() const noexcept
+  -> T* {
+  return nullptr;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::last() const noexcept -> T* {
+  return last_;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::next(T* p) const noexcept
+  -> T* {
+  return p ? p->*Next : first_;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::search(
+  const std::predicate<const T&> auto& f) const
+  noexcept(noexcept(f(std::declval<const T&>()))) -> T* {
+  for (auto p = first_; p != nullptr; p = p->*Next)
+    if (f(static_cast<const T&>(*p)))
+      return p;
+  return nullptr;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::insert_after(T* prev,
+                                          T& value) noexcept
+  -> T* {
+  value.*Next = std::exchange(link(prev), &value);
+
+  if (value.*Next == nullptr)
+    last_ = &value;
+
+  return &value;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::remove_after(T* prev) -> T* {
+  if (link(prev) == nullptr)
+    throw std::runtime_error{"cannot remove past end"};
+  return unchecked_remove_after(prev);
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::try_remove_after(
+  T* prev) noexcept -> T* {
+  if (link(prev) == nullptr)
+    return nullptr;
+  return unchecked_remove_after(prev);
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::unchecked_remove_after(
+  T* prev) noexcept -> T* {
+  auto node = link(prev);
+  assert(node != nullptr);
+
+  link(prev) = std::exchange(node->*Next, nullptr);
+
+  if (link(prev) == nullptr)
+    last_ = prev;
+
+  return node;
+}
+
+// Returns the element that followed prev, or the new last
+// element when there was none, like List::graft_after.
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::graft_after(
+  T* prev, IntrusiveList& list) noexcept -> T* {
+  if (list.is_empty())
+    return prev;
+
+  auto last = list.last_;
+  auto next = last->*Next =
+    std::exchange(link(prev), list.first_);
+
+  if (next == nullptr)
+    last_ = last;
+
+  list.first_ = list.last_ = nullptr;
+
+  return next ? next : last_;
+}
+
+// (prev, last]
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::extract_between(
+  T* prev, T* last) noexcept -> IntrusiveList {
+  if (prev == last or link(prev) == nullptr)
+    return {};
+
+  IntrusiveList list;
+
+  list.first_ = link(prev);
+  list.last_ = last;
+
+  link(prev) = std::exchange(last->*Next, nullptr);
+
+  if (link(prev) == nullptr)
+    last_ = prev;
+
+  return list;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::concatenate(
+  IntrusiveList& list) noexcept -> T* {
+  return graft_after(last_, list);
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::split_after(T* prev) noexcept
+  -> IntrusiveList {
+  if (link(prev) == nullptr)
+    return {};
+
+  IntrusiveList list;
+
+  list.first_ = std::exchange(link(prev), nullptr);
+  list.last_ = std::exchange(last_, prev);
+
+  return list;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::is_empty() const noexcept
+  -> bool {
+  return first_ == nullptr;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveList<T, Next>::link(T* prev) noexcept -> T*& {
+  return prev ? prev->*Next : first_;
+}
+
+#endif // LINKED_LIST_INTRUSIVE_HPP
@@ -0,0 +1,171 @@
+#ifndef PAGE_ALLOCATOR_HPP
+#define PAGE_ALLOCATOR_HPP
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct PageOptions {
+  // Allocations of at least this many bytes are mapped
+  // straight from the kernel, in whole huge pages.
+  std::size_t threshold = std::size_t{2} << 20;
+
+  // Asks the kernel to back mappings with transparent huge
+  // pages.
+  bool transparent_huge_pages = true;
+
+  // Tries 2 MiB MAP_HUGETLB pages first. They need to be
+  // reserved in /sys/kernel/mm/hugepages/hugepages-2048kB;
+  // without them mappings fall back to regular pages.
+  bool explicit_huge_pages = false;
+
+  // NUMA node to bind mappings to. When negative, each page
+  // lands on the node of the thread that first touches it.
+  int numa_node = -1;
+};
+
+// Copied by each PageAllocator when it is constructed, so
+// a change applies to allocators made after it.
+inline PageOptions page_options;
+
+// Allocates like std::allocator, except that buffers of at
+// least page_options.threshold bytes are mapped directly,
+// aligned to huge pages, so that large scans take fewer TLB
+// misses. The options are captured on construction, since
+// deallocation must take the same path as allocation, and
+// a mapping must not see half of a concurrent change.
+template <class T>
+class PageAllocator : private std::allocator<T> {
+public:
+  static constexpr std::size_t huge_page = 2 << 20;
+
+  PageAllocator() noexcept : options_{page_options} {}
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T*;
+  void deallocate(T*, std::size_t) noexcept;
+
+private:
+  auto is_mapped(std::size_t n) const noexcept -> bool;
+  static auto mapped_size(std::size_t n) noexcept
+    -> std::size_t;
+  static constexpr auto round_up(std::size_t) noexcept
+    -> std::size_t;
+  auto map(std::size_t bytes) const -> void*;
+
+  PageOptions options_;
+};
+
+template <class T>
+auto PageAllocator<T>::allocate(std::size_t n) -> T* {
+#ifdef __linux__
+  if (is_mapped(n))
+    return static_cast<T*>(map(mapped_size(n)));
+#endif
+  return std::allocator<T>::allocate(n);
+}
+
+template <class T>
+void PageAllocator<T>::deallocate(T* p,
+                                  std::size_t n) noexcept {
+#ifdef __linux__
+  if (is_mapped(n)) {
+    munmap(p, mapped_size(n));
+    return;
+  }
+#endif
+  std::allocator<T>::deallocate(p, n);
+}
+
+// Sizes too large to round up are left to std::allocator,
+// which rejects them.
+template <class T>
+auto PageAllocator<T>::is_mapped(
+  std::size_t n) const noexcept -> bool {
+  constexpr auto limit = (SIZE_MAX - huge_page) / sizeof(T);
+  return n > 0 and n <= limit and
+         n * sizeof(T) >= options_.threshold;
+}
+
+// Mappings span whole huge pages, so that MAP_HUGETLB ones
+// can be unmapped with the same length as regular ones.
+template <class T>
+auto PageAllocator<T>::mapped_size(std::size_t n) noexcept
+  -> std::size_t {
+  return round_up(n * sizeof(T));
+}
+
+template <class T>
+constexpr auto PageAllocator<T>::round_up(
+  std::size_t bytes) noexcept -> std::size_t {
+  return (bytes + huge_page - 1) & ~(huge_page - 1);
+}
+
+#ifdef __linux__
+
+template <class T>
+auto PageAllocator<T>::map(std::size_t bytes) const
+  -> void* {
+  constexpr auto protection = PROT_READ | PROT_WRITE;
+  constexpr auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  void* p = MAP_FAILED;
+#ifdef MAP_HUGE_SHIFT
+  // The page size is given explicitly, since the default
+  // may be 1 GiB, and mappings are unmapped in whole 2 MiB
+  // pages. Without MAP_HUGE_SHIFT it cannot be, so explicit
+  // huge pages are not used.
+  constexpr auto huge_2mb = std::countr_zero(huge_page)
+                            << MAP_HUGE_SHIFT;
+  if (options_.explicit_huge_pages)
+    p = mmap(nullptr, bytes, protection,
+             flags | MAP_HUGETLB | huge_2mb, -1, 0);
+#endif
+
+  if (p == MAP_FAILED) {
+    // Over-map by one huge page and trim both ends, so that
+    // the mapping starts on a huge page boundary.
+    auto raw = mmap(nullptr, bytes + huge_page, protection,
+                    flags, -1, 0);
+    if (raw == MAP_FAILED)
+      throw std::bad_alloc{};
+
+    auto first = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = round_up(first);
+    auto head = aligned - first;
+    if (head > 0)
+      munmap(raw, head);
+    munmap(reinterpret_cast<void*>(aligned + bytes),
+           huge_page - head);
+
+    p = reinterpret_cast<void*>(aligned);
+    if (options_.transparent_huge_pages)
+      madvise(p, bytes, MADV_HUGEPAGE);
+  }
+
+  // Binding is best effort: kernels without NUMA support
+  // reject mbind, and the memory is still usable.
+  if (options_.numa_node >= 0) {
+    constexpr auto bind = 2; // MPOL_BIND
+    constexpr auto bits = 8 * sizeof(unsigned long);
+    unsigned long mask[4] = {};
+    auto node =
+      static_cast<std::size_t>(options_.numa_node);
+    if (node < 4 * bits) {
+      mask[node / bits] = 1ul << (node % bits);
+      syscall(SYS_mbind, p, bytes, bind, mask, 4 * bits, 0);
+    }
+  }
+
+  return p;
+}
+
+#endif // __linux__
+
+#endif // PAGE_ALLOCATOR_HPP
@@ -1,38 +1,129 @@
 #ifndef QUEUE_CIRCULAR_HPP
 #define QUEUE_CIRCULAR_HPP
 
+#include "linear/page_allocator.hpp"
+#include "linear/simd.hpp"
+#include "linear/snapshot.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// The linked variant is linked::Queue.
+namespace contiguous {
 
 template <std::movable T>
-class Queue : private std::allocator<T> {
+class Queue : private PageAllocator<T> {
 public:
+  struct Options {
+    // When non-zero, growing only allocates the new buffer;
+    // each later enqueue or dequeue then moves this many
+    // elements over until the old buffer is empty.
+    std::size_t migration_step = 0;
+
+    // When non-zero, the buffer is halved once at most
+    // 1/shrink_ratio of it is in use. Must be greater than
+    // 2 so that a halved buffer is never full, and at least
+    // 4 with a migration step, so that a shrink migration
+    // ends before the halved buffer can fill up.
+    std::size_t shrink_ratio = 0;
+  };
+
+  Queue() noexcept = default;
+  explicit Queue(Options);
   ~Queue() noexcept;
 
   void enqueue(T);
   void dequeue();
+  [[nodiscard]] auto front() -> T&;
   [[nodiscard]] auto front() const -> const T&;
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  [[nodiscard]] auto try_dequeue() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] auto dequeue_value() -> T;
+
+  // Expect a non-empty queue, checked only by assert.
+  [[nodiscard]] auto unchecked_front() const noexcept
+    -> const T&;
+  void unchecked_dequeue() noexcept;
+  [[nodiscard]] auto capacity() const noexcept
+    -> std::size_t;
+
+  void shrink_to_fit();
+
+  [[nodiscard]] auto find(const T&) const -> const T*
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto find(
+    const std::predicate<const T&> auto&) const -> const T*;
+  [[nodiscard]] auto count(const T&) const -> std::size_t
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto count(
+    const std::predicate<const T&> auto&) const
+    -> std::size_t;
+  [[nodiscard]] auto contains(const T&) const -> bool
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto contains(
+    const std::predicate<const T&> auto&) const -> bool;
+
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   void double_capacity();
+  void resize(std::size_t);
+  void reallocate(std::size_t);
+  void begin_migration(std::size_t);
+  void migrate(std::size_t);
+  auto at(std::size_t) const noexcept -> T&;
+  void for_each_segment(auto&&) const;
   auto wrap(std::size_t) const noexcept -> std::size_t;
 
   std::size_t begin_ = 0;
   std::size_t size_ = 0;
   std::size_t capacity_ = 0;
   T* values_ = nullptr;
+
+  // The first pending_ elements still live in old_values_.
+  std::size_t old_begin_ = 0;
+  std::size_t old_capacity_ = 0;
+  T* old_values_ = nullptr;
+  std::size_t pending_ = 0;
+  std::size_t migration_step_ = 0;
+  std::size_t shrink_ratio_ = 0;
 };
 
+template <std::movable T>
+Queue<T>::Queue(Options options)
+  : migration_step_{options.migration_step},
+    shrink_ratio_{options.shrink_ratio} {
+  if (shrink_ratio_ == 1 or shrink_ratio_ == 2)
+    throw std::invalid_argument{"shrink ratio must be > 2"};
+  if (migration_step_ > 0 and shrink_ratio_ > 0 and
+      shrink_ratio_ < 4)
+    throw std::invalid_argument{
+      "shrink ratio must be >= 4 with a migration step"};
+}
+
 template <std::movable T>
 Queue<T>::~Queue() noexcept {
   for (std::size_t i = 0; i < size_; ++i)
-    values_[wrap(begin_ + i)].~T();
+    at(i).~T();
+  this->deallocate(old_values_, old_capacity_);
   this->deallocate(values_, capacity_);
 }
 
 template <std::movable T>
 void Queue<T>::enqueue(T value) {
+  migrate(migration_step_);
   if (size_ == capacity_)
     double_capacity();
   new (values_ + wrap(begin_ + size_)) T(std::move(value));
@@ -43,16 +134,21 @@ template <std::movable T>
 void Queue<T>::dequeue() {
   if (is_empty())
     throw std::runtime_error{"no element to dequeue"};
-  values_[begin_].~T();
-  begin_ = wrap(begin_ + 1);
-  --size_;
+  unchecked_dequeue();
+}
+
+template <std::movable T>
+auto Queue<T>::front() -> T& {
+  if (is_empty())
+    throw std::runtime_error{"empty queue has no front"};
+  return at(0);
 }
 
 template <std::movable T>
 auto Queue<T>::front() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty queue has no front"};
-  return values_[begin_];
+  return unchecked_front();
 }
 
 template <std::movable T>
@@ -60,9 +156,186 @@ auto Queue<T>::is_empty() const noexcept -> bool {
   return size_ == 0;
 }
 
+template <std::movable T>
+auto Queue<T>::try_dequeue() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(at(0))};
+  unchecked_dequeue();
+  return value;
+}
+
+// Moves the front out instead of copying it before the
+// dequeue.
+template <std::movable T>
+auto Queue<T>::dequeue_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to dequeue"};
+  auto value = std::move(at(0));
+  unchecked_dequeue();
+  return value;
+}
+
+template <std::movable T>
+auto Queue<T>::unchecked_front() const noexcept
+  -> const T& {
+  assert(not is_empty());
+  return at(0);
+}
+
+template <std::movable T>
+void Queue<T>::unchecked_dequeue() noexcept {
+  assert(not is_empty());
+  at(0).~T();
+  if (pending_ > 0) {
+    old_begin_ = (old_begin_ + 1) % old_capacity_;
+    --pending_;
+  }
+  begin_ = wrap(begin_ + 1);
+  --size_;
+
+  // The element is gone either way. Migrating and shrinking
+  // leave the queue unchanged when they throw, so a failure
+  // only defers them to a later operation.
+  try {
+    migrate(migration_step_);
+    if (shrink_ratio_ > 0 and pending_ == 0 and
+        capacity_ > 1 and
+        size_ * shrink_ratio_ <= capacity_)
+      resize(capacity_ / 2);
+  } catch (...) {
+  }
+}
+
+template <std::movable T>
+auto Queue<T>::capacity() const noexcept -> std::size_t {
+  return capacity_;
+}
+
+template <std::movable T>
+void Queue<T>::shrink_to_fit() {
+  if (size_ < capacity_)
+    reallocate(size_);
+}
+
+// Searches run over each contiguous segment in turn, from
+// front to back, and return the first match.
+template <std::movable T>
+auto Queue<T>::find(const T& value) const -> const T*
+  requires std::equality_comparable<T> {
+  const T* found = nullptr;
+  for_each_segment([&](const T* values, std::size_t n) {
+    if (not found)
+      found = find_value(values, n, value);
+  });
+  return found;
+}
+
+template <std::movable T>
+auto Queue<T>::find(
+  const std::predicate<const T&> auto& f) const
+  -> const T* {
+  const T* found = nullptr;
+  for_each_segment([&](const T* values, std::size_t n) {
+    if (not found) {
+      auto p = std::find_if(values, values + n, f);
+      found = p == values + n ? nullptr : p;
+    }
+  });
+  return found;
+}
+
+template <std::movable T>
+auto Queue<T>::count(const T& value) const -> std::size_t
+  requires std::equality_comparable<T> {
+  std::size_t count = 0;
+  for_each_segment([&](const T* values, std::size_t n) {
+    count += count_value(values, n, value);
+  });
+  return count;
+}
+
+template <std::movable T>
+auto Queue<T>::count(
+  const std::predicate<const T&> auto& f) const
+  -> std::size_t {
+  std::size_t count = 0;
+  for_each_segment([&](const T* values, std::size_t n) {
+    count += std::count_if(values, values + n, f);
+  });
+  return count;
+}
+
+template <std::movable T>
+auto Queue<T>::contains(const T& value) const -> bool
+  requires std::equality_comparable<T> {
+  return find(value) != nullptr;
+}
+
+template <std::movable T>
+auto Queue<T>::contains(
+  const std::predicate<const T&> auto& f) const -> bool {
+  return find(f) != nullptr;
+}
+
+template <std::movable T>
+void Queue<T>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  write_header<T>(writer, size_);
+  for_each_segment([&](const T* values, std::size_t n) {
+    if constexpr (BitwiseSnapshottable<T>)
+      write_values(writer, values, n);
+    else
+      for (std::size_t i = 0; i < n; ++i)
+        write_element(writer, values[i]);
+  });
+}
+
+// Raw elements are read straight into the buffer; others
+// are enqueued one by one as they are deserialized.
+
+template <std::movable T>
+void Queue<T>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  auto count = read_header<T>(reader);
+  if constexpr (BitwiseSnapshottable<T>) {
+    if (count == 0)
+      return;
+    if (count > SIZE_MAX / sizeof(T) - size_)
+      throw std::runtime_error{
+        "snapshot count is too large"};
+    if (size_ + count > capacity_)
+      reallocate(size_ + count);
+
+    auto end = wrap(begin_ + size_);
+    auto first = std::min(count, capacity_ - end);
+    read_values(reader, values_ + end, first);
+    read_values(reader, values_, count - first);
+    size_ += count;
+  } else {
+    for (; count > 0; --count)
+      enqueue(read_element<T>(reader));
+  }
+}
+
 template <std::movable T>
 void Queue<T>::double_capacity() {
-  auto new_capacity = capacity_ == 0 ? 1 : 2 * capacity_;
+  resize(capacity_ == 0 ? 1 : 2 * capacity_);
+}
+
+template <std::movable T>
+void Queue<T>::resize(std::size_t new_capacity) {
+  if (migration_step_ > 0 and size_ > 0)
+    begin_migration(new_capacity);
+  else
+    reallocate(new_capacity);
+}
+
+template <std::movable T>
+void Queue<T>::reallocate(std::size_t new_capacity) {
+  migrate(pending_);
   auto buffer = this->allocate(new_capacity);
 
   std::size_t i;
@@ -85,10 +358,68 @@ void Queue<T>::double_capacity() {
   capacity_ = new_capacity;
 }
 
+template <std::movable T>
+void Queue<T>::begin_migration(std::size_t new_capacity) {
+  migrate(pending_);
+  auto buffer = this->allocate(new_capacity);
+
+  old_values_ = std::exchange(values_, buffer);
+  old_capacity_ = std::exchange(capacity_, new_capacity);
+  old_begin_ = std::exchange(begin_, 0);
+  pending_ = size_;
+}
+
+// Moves up to n elements out of the old buffer, back first.
+template <std::movable T>
+void Queue<T>::migrate(std::size_t n) {
+  for (; n > 0 and pending_ > 0; --n) {
+    auto& value = at(pending_ - 1);
+    new (values_ + wrap(begin_ + pending_ - 1))
+      T(std::move_if_noexcept(value));
+    value.~T();
+    --pending_;
+  }
+
+  if (pending_ == 0 and old_values_) {
+    this->deallocate(old_values_, old_capacity_);
+    old_values_ = nullptr;
+    old_capacity_ = 0;
+  }
+}
+
+template <std::movable T>
+auto Queue<T>::at(std::size_t i) const noexcept -> T& {
+  if (i < pending_)
+    return old_values_[(old_begin_ + i) % old_capacity_];
+  return values_[wrap(begin_ + i)];
+}
+
+// Calls f(pointer, count) for each contiguous run of
+// elements, from front to back.
+template <std::movable T>
+void Queue<T>::for_each_segment(auto&& f) const {
+  auto ring = [&](const T* values, std::size_t capacity,
+                  std::size_t begin, std::size_t n) {
+    if (n == 0)
+      return;
+    begin %= capacity;
+    auto first = std::min(n, capacity - begin);
+    f(values + begin, first);
+    if (n > first)
+      f(values, n - first);
+  };
+
+  ring(old_values_, old_capacity_, old_begin_, pending_);
+  ring(values_, capacity_, begin_ + pending_,
+       size_ - pending_);
+}
+
 template <std::movable T>
 auto Queue<T>::wrap(std::size_t i) const noexcept
   -> std::size_t {
   return i % capacity_;
 }
 
+} // namespace contiguous
+
 #endif // QUEUE_CIRCULAR_HPP
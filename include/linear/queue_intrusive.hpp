@@ -0,0 +1,80 @@
+#ifndef QUEUE_INTRUSIVE_HPP
+#define QUEUE_INTRUSIVE_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+// Queues objects owned elsewhere through their own `Next`
+// member; nothing is allocated or copied.
+template <class T, T* T::*Next>
+class IntrusiveQueue {
+public:
+  void enqueue(T&) noexcept;
+  void dequeue();
+  [[nodiscard]] auto front() const -> T&;
+  [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+  // Returns nullptr when the queue is empty.
+  auto try_dequeue() noexcept -> T*;
+
+  // Expect a non-empty queue, checked only by assert.
+  [[nodiscard]] auto unchecked_front() const noexcept -> T&;
+  void unchecked_dequeue() noexcept;
+
+private:
+  T* front_ = nullptr;
+  T* rear_ = nullptr;
+};
+
+template <class T, T* T::*Next>
+void IntrusiveQueue<T, Next>::enqueue(T& value) noexcept {
+  value.*Next = nullptr;
+  if (is_empty())
+    front_ = rear_ = &value;
+  else
+    rear_ = rear_->*Next = &value;
+}
+
+template <class T, T* T::*Next>
+void IntrusiveQueue<T, Next>::dequeue() {
+  if (is_empty())
+    throw std::runtime_error{"no element to dequeue"};
+  unchecked_dequeue();
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveQueue<T, Next>::front() const -> T& {
+  if (is_empty())
+    throw std::runtime_error{"empty queue has no front"};
+  return unchecked_front();
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveQueue<T, Next>::is_empty() const noexcept
+  -> bool {
+  return front_ == nullptr;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveQueue<T, Next>::try_dequeue() noexcept -> T* {
+  auto front = front_;
+  if (front)
+    unchecked_dequeue();
+  return front;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveQueue<T, Next>::unchecked_front()
+  const noexcept -> T& {
+  assert(not is_empty());
+  return *front_;
+}
+
+template <class T, T* T::*Next>
+void IntrusiveQueue<T, Next>::unchecked_dequeue() noexcept {
+  assert(not is_empty());
+  front_ = std::exchange(front_->*Next, nullptr);
+}
+
+#endif // QUEUE_INTRUSIVE_HPP
@@ -1,9 +1,17 @@
 #ifndef QUEUE_LINKED_HPP
 #define QUEUE_LINKED_HPP
 
+#include "linear/snapshot.hpp"
+
+#include <cassert>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+// The circular buffer variant is contiguous::Queue.
+namespace linked {
+
 template <std::movable T>
 class Queue {
 public:
@@ -14,6 +22,21 @@ public:
   [[nodiscard]] auto front() const -> const T&;
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  [[nodiscard]] auto try_dequeue() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] auto dequeue_value() -> T;
+
+  // Expect a non-empty queue, checked only by assert.
+  [[nodiscard]] auto unchecked_front() const noexcept
+    -> const T&;
+  void unchecked_dequeue() noexcept;
+
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   struct Node {
     T value;
@@ -43,14 +66,14 @@ template <std::movable T>
 void Queue<T>::dequeue() {
   if (is_empty())
     throw std::runtime_error{"no element to dequeue"};
-  delete std::exchange(front_, front_->next);
+  unchecked_dequeue();
 }
 
 template <std::movable T>
 auto Queue<T>::front() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty queue has no front"};
-  return front_->value;
+  return unchecked_front();
 }
 
 template <std::movable T>
@@ -58,4 +81,61 @@ auto Queue<T>::is_empty() const noexcept -> bool {
   return front_ == nullptr;
 }
 
+template <std::movable T>
+auto Queue<T>::try_dequeue() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(front_->value)};
+  unchecked_dequeue();
+  return value;
+}
+
+// Moves the front out instead of copying it before the
+// dequeue.
+template <std::movable T>
+auto Queue<T>::dequeue_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to dequeue"};
+  auto value = std::move(front_->value);
+  unchecked_dequeue();
+  return value;
+}
+
+template <std::movable T>
+auto Queue<T>::unchecked_front() const noexcept
+  -> const T& {
+  assert(not is_empty());
+  return front_->value;
+}
+
+template <std::movable T>
+void Queue<T>::unchecked_dequeue() noexcept {
+  assert(not is_empty());
+  delete std::exchange(front_, front_->next);
+}
+
+template <std::movable T>
+void Queue<T>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  std::size_t count = 0;
+  for (auto p = front_; p; p = p->next)
+    ++count;
+
+  write_header<T>(writer, count);
+  for (auto p = front_; p; p = p->next)
+    write_element(writer, p->value);
+}
+
+template <std::movable T>
+void Queue<T>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  for (auto count = read_header<T>(reader);
+       count > 0; --count)
+    enqueue(read_element<T>(reader));
+}
+
+} // namespace linked
+
 #endif // QUEUE_LINKED_HPP
@@ -0,0 +1,191 @@
+#ifndef QUEUE_SHARDED_HPP
+#define QUEUE_SHARDED_HPP
+
+#include "linear/queue_circular.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+
+// Concurrent queue made of one circular Queue per shard.
+// Producers enqueue on their thread's shard. Consumers
+// sample the older front of two random shards, and take
+// from their own shard only when its front is at least as
+// old as the sample.
+//
+// Ordering is relaxed: each shard is FIFO, but elements on
+// different shards may be dequeued out of order. Since the
+// local shard never wins over an older sample, a dequeue is
+// never worse than a pure two-choice pick, whose expected
+// rank error is O(number of shards), independent of the
+// queue length.
+template <std::movable T>
+class MultiQueue {
+public:
+  struct Statistics {
+    std::size_t enqueued;
+    std::size_t dequeued;
+    // Dequeued by threads that belong to another shard.
+    std::size_t stolen;
+    std::size_t size;
+  };
+
+  explicit MultiQueue(
+    std::size_t = std::thread::hardware_concurrency());
+
+  void enqueue(T);
+  [[nodiscard]] auto try_dequeue() -> std::optional<T>;
+
+  [[nodiscard]] auto shards() const noexcept -> std::size_t;
+  [[nodiscard]] auto statistics(std::size_t shard) const
+    -> Statistics;
+
+private:
+  static constexpr auto empty =
+    std::numeric_limits<std::uint64_t>::max();
+
+  // Aligned so that shards never share a cache line.
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    contiguous::Queue<std::pair<std::uint64_t, T>> entries;
+    std::atomic<std::uint64_t> front_stamp = empty;
+    Statistics statistics = {};
+  };
+
+  static auto thread_index() noexcept -> std::size_t;
+  auto home() const noexcept -> Shard&;
+  auto random() const noexcept -> Shard&;
+  static auto stamp(const Shard&) noexcept -> std::uint64_t;
+  static auto take(Shard&, bool stolen) -> T;
+
+  std::size_t count_;
+  std::unique_ptr<Shard[]> shards_;
+
+  inline static std::atomic<std::size_t> threads_ = 0;
+};
+
+template <std::movable T>
+MultiQueue<T>::MultiQueue(std::size_t shards)
+  : count_{std::max<std::size_t>(shards, 1)},
+    shards_{new Shard[count_]} {}
+
+template <std::movable T>
+void MultiQueue<T>::enqueue(T value) {
+  auto& shard = home();
+  std::scoped_lock lock{shard.mutex};
+
+  auto now = static_cast<std::uint64_t>(
+    std::chrono::steady_clock::now()
+      .time_since_epoch()
+      .count());
+  shard.entries.enqueue({now, std::move(value)});
+
+  if (shard.statistics.size++ == 0)
+    shard.front_stamp.store(now, std::memory_order_relaxed);
+  ++shard.statistics.enqueued;
+}
+
+template <std::movable T>
+auto MultiQueue<T>::try_dequeue() -> std::optional<T> {
+  auto& local = home();
+
+  for (std::size_t tries = 0; tries < count_; ++tries) {
+    auto& a = random();
+    auto& b = random();
+    auto& sample = stamp(a) <= stamp(b) ? a : b;
+    auto& shard =
+      stamp(local) <= stamp(sample) ? local : sample;
+    if (stamp(shard) == empty)
+      continue;
+
+    std::unique_lock lock{shard.mutex, std::try_to_lock};
+    if (lock and not shard.entries.is_empty())
+      return take(shard, &shard != &local);
+  }
+
+  // Random picks can miss the last non-empty shards; sweep
+  // them all before reporting the queue as empty.
+  for (std::size_t i = 0; i < count_; ++i) {
+    std::scoped_lock lock{shards_[i].mutex};
+    if (not shards_[i].entries.is_empty())
+      return take(shards_[i], &shards_[i] != &local);
+  }
+
+  return std::nullopt;
+}
+
+template <std::movable T>
+auto MultiQueue<T>::shards() const noexcept -> std::size_t {
+  return count_;
+}
+
+template <std::movable T>
+auto MultiQueue<T>::statistics(std::size_t shard) const
+  -> Statistics {
+  std::scoped_lock lock{shards_[shard].mutex};
+  return shards_[shard].statistics;
+}
+
+// Numbers threads in the order they first use a queue.
+template <std::movable T>
+auto MultiQueue<T>::thread_index() noexcept -> std::size_t {
+  thread_local const auto index = threads_++;
+  return index;
+}
+
+template <std::movable T>
+auto MultiQueue<T>::home() const noexcept -> Shard& {
+  return shards_[thread_index() % count_];
+}
+
+// Seeded with a hash of the thread index, since adjacent
+// seeds give linearly related sequences, and threads that
+// start together would pick shards in lockstep.
+template <std::movable T>
+auto MultiQueue<T>::random() const noexcept -> Shard& {
+  thread_local std::minstd_rand engine = [] {
+    std::uint64_t z = thread_index();
+    z *= 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return std::minstd_rand(
+      static_cast<std::uint_fast32_t>(z ^ (z >> 31)));
+  }();
+  return shards_[engine() % count_];
+}
+
+// Read without the lock, so it is only a hint.
+template <std::movable T>
+auto MultiQueue<T>::stamp(const Shard& shard) noexcept
+  -> std::uint64_t {
+  return shard.front_stamp.load(std::memory_order_relaxed);
+}
+
+// Expects the shard to be locked and not empty.
+template <std::movable T>
+auto MultiQueue<T>::take(Shard& shard, bool stolen) -> T {
+  auto value = std::move(shard.entries.front().second);
+  shard.entries.dequeue();
+
+  shard.front_stamp.store(shard.entries.is_empty()
+                            ? empty
+                            : shard.entries.front().first,
+                          std::memory_order_relaxed);
+
+  --shard.statistics.size;
+  ++shard.statistics.dequeued;
+  if (stolen)
+    ++shard.statistics.stolen;
+
+  return value;
+}
+
+#endif // QUEUE_SHARDED_HPP
@@ -0,0 +1,128 @@
+#ifndef QUEUE_STATIC_HPP
+#define QUEUE_STATIC_HPP
+
+#include "linear/static_storage.hpp"
+
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+template <std::movable T, std::size_t N>
+class StaticQueue {
+public:
+  constexpr StaticQueue() noexcept {}
+  constexpr ~StaticQueue() noexcept;
+
+  [[nodiscard]] constexpr auto enqueue(T) -> bool;
+  constexpr void dequeue();
+  [[nodiscard]] constexpr auto front() const -> const T&;
+  [[nodiscard]] constexpr auto is_empty() const noexcept
+    -> bool;
+  [[nodiscard]] constexpr auto is_full() const noexcept
+    -> bool;
+
+  [[nodiscard]] constexpr auto try_dequeue() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] constexpr auto dequeue_value() -> T;
+
+  // Expect a non-empty queue, checked only by assert.
+  [[nodiscard]] constexpr auto unchecked_front()
+    const noexcept -> const T&;
+  constexpr void unchecked_dequeue() noexcept;
+
+private:
+  constexpr auto wrap(std::size_t) const noexcept
+    -> std::size_t;
+
+  std::size_t begin_ = 0;
+  std::size_t size_ = 0;
+  StaticStorage<T, N> values_;
+};
+
+template <std::movable T, std::size_t N>
+constexpr StaticQueue<T, N>::~StaticQueue() noexcept {
+  for (std::size_t i = 0; i < size_; ++i)
+    values_.destroy(wrap(begin_ + i));
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::enqueue(T value) -> bool {
+  if (is_full())
+    return false;
+  values_.construct(wrap(begin_ + size_), std::move(value));
+  ++size_;
+  return true;
+}
+
+template <std::movable T, std::size_t N>
+constexpr void StaticQueue<T, N>::dequeue() {
+  if (is_empty())
+    throw std::runtime_error{"no element to dequeue"};
+  unchecked_dequeue();
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::front() const
+  -> const T& {
+  if (is_empty())
+    throw std::runtime_error{"empty queue has no front"};
+  return unchecked_front();
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::is_empty() const noexcept
+  -> bool {
+  return size_ == 0;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::is_full() const noexcept
+  -> bool {
+  return size_ == N;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::try_dequeue() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(values_[begin_])};
+  unchecked_dequeue();
+  return value;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::dequeue_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to dequeue"};
+  auto value = std::move(values_[begin_]);
+  unchecked_dequeue();
+  return value;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::unchecked_front()
+  const noexcept -> const T& {
+  assert(not is_empty());
+  return values_[begin_];
+}
+
+template <std::movable T, std::size_t N>
+constexpr void
+StaticQueue<T, N>::unchecked_dequeue() noexcept {
+  assert(not is_empty());
+  values_.destroy(begin_);
+  begin_ = wrap(begin_ + 1);
+  --size_;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticQueue<T, N>::wrap(
+  std::size_t i) const noexcept -> std::size_t {
+  return i % N;
+}
+
+#endif // QUEUE_STATIC_HPP
@@ -0,0 +1,208 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) and defined(__GNUC__)
+#include <immintrin.h>
+#define LINEAR_SIMD_X86
+#endif
+
+// Types whose equality is equality of their bytes.
+template <class T>
+concept BytewiseComparable =
+  (std::is_integral_v<T> or std::is_enum_v<T> or
+   std::is_pointer_v<T>) and
+  (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or
+   sizeof(T) == 8);
+
+#ifdef LINEAR_SIMD_X86
+
+// Turns a byte mask from movemask into one bit per lane of
+// W bytes, set when all the bytes of the lane matched.
+template <std::size_t W>
+auto lane_mask(std::uint32_t bytes) noexcept
+  -> std::uint32_t {
+  auto lanes = bytes;
+  for (std::size_t k = 1; k < W; ++k)
+    lanes &= bytes >> k;
+
+  if constexpr (W == 2)
+    return lanes & 0x55555555u;
+  else if constexpr (W == 4)
+    return lanes & 0x11111111u;
+  else if constexpr (W == 8)
+    return lanes & 0x01010101u;
+  else
+    return lanes;
+}
+
+template <std::size_t W>
+auto broadcast_sse2(std::uint64_t bits) noexcept
+  -> __m128i {
+  if constexpr (W == 1)
+    return _mm_set1_epi8(static_cast<char>(bits));
+  else if constexpr (W == 2)
+    return _mm_set1_epi16(static_cast<short>(bits));
+  else if constexpr (W == 4)
+    return _mm_set1_epi32(static_cast<int>(bits));
+  else
+    return _mm_set1_epi64x(static_cast<long long>(bits));
+}
+
+template <std::size_t W>
+__attribute__((target("avx2"))) auto
+broadcast_avx2(std::uint64_t bits) noexcept -> __m256i {
+  if constexpr (W == 1)
+    return _mm256_set1_epi8(static_cast<char>(bits));
+  else if constexpr (W == 2)
+    return _mm256_set1_epi16(static_cast<short>(bits));
+  else if constexpr (W == 4)
+    return _mm256_set1_epi32(static_cast<int>(bits));
+  else
+    return _mm256_set1_epi64x(static_cast<long long>(bits));
+}
+
+template <std::size_t W>
+auto matches_sse2(const std::byte* p, __m128i needle) noexcept
+  -> std::uint32_t {
+  auto block =
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  return lane_mask<W>(static_cast<std::uint32_t>(
+    _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+}
+
+template <std::size_t W>
+__attribute__((target("avx2"))) auto
+matches_avx2(const std::byte* p, __m256i needle) noexcept
+  -> std::uint32_t {
+  auto block =
+    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  auto bytes = _mm256_cmpeq_epi8(block, needle);
+  return lane_mask<W>(static_cast<std::uint32_t>(
+    _mm256_movemask_epi8(bytes)));
+}
+
+// The kernels handle whole blocks only and report how many
+// elements they covered; the caller finishes the tail.
+
+template <BytewiseComparable T>
+auto find_sse2(const T* first, std::size_t n, const T& value,
+               std::size_t& done) noexcept -> const T* {
+  constexpr auto lanes = 16 / sizeof(T);
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  auto needle = broadcast_sse2<sizeof(T)>(bits);
+
+  for (done = 0; done + lanes <= n; done += lanes)
+    if (auto m = matches_sse2<sizeof(T)>(
+          reinterpret_cast<const std::byte*>(first + done),
+          needle))
+      return first + done + std::countr_zero(m) / sizeof(T);
+  return nullptr;
+}
+
+template <BytewiseComparable T>
+__attribute__((target("avx2"))) auto
+find_avx2(const T* first, std::size_t n, const T& value,
+          std::size_t& done) noexcept -> const T* {
+  constexpr auto lanes = 32 / sizeof(T);
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  auto needle = broadcast_avx2<sizeof(T)>(bits);
+
+  for (done = 0; done + lanes <= n; done += lanes)
+    if (auto m = matches_avx2<sizeof(T)>(
+          reinterpret_cast<const std::byte*>(first + done),
+          needle))
+      return first + done + std::countr_zero(m) / sizeof(T);
+  return nullptr;
+}
+
+template <BytewiseComparable T>
+auto count_sse2(const T* first, std::size_t n, const T& value,
+                std::size_t& done) noexcept -> std::size_t {
+  constexpr auto lanes = 16 / sizeof(T);
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  auto needle = broadcast_sse2<sizeof(T)>(bits);
+
+  std::size_t count = 0;
+  for (done = 0; done + lanes <= n; done += lanes)
+    count += std::popcount(matches_sse2<sizeof(T)>(
+      reinterpret_cast<const std::byte*>(first + done),
+      needle));
+  return count;
+}
+
+template <BytewiseComparable T>
+__attribute__((target("avx2"))) auto
+count_avx2(const T* first, std::size_t n, const T& value,
+           std::size_t& done) noexcept -> std::size_t {
+  constexpr auto lanes = 32 / sizeof(T);
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(T));
+  auto needle = broadcast_avx2<sizeof(T)>(bits);
+
+  std::size_t count = 0;
+  for (done = 0; done + lanes <= n; done += lanes)
+    count += std::popcount(matches_avx2<sizeof(T)>(
+      reinterpret_cast<const std::byte*>(first + done),
+      needle));
+  return count;
+}
+
+inline auto has_avx2() noexcept -> bool {
+  static const bool supported =
+    __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+#endif // LINEAR_SIMD_X86
+
+// Returns the first element of [first, first + n) equal to
+// value, or nullptr. Bytewise comparable types are scanned
+// with AVX2 or SSE2 when the CPU has them.
+template <std::equality_comparable T>
+auto find_value(const T* first, std::size_t n,
+                const T& value) -> const T* {
+  std::size_t done = 0;
+
+#ifdef LINEAR_SIMD_X86
+  if constexpr (BytewiseComparable<T>) {
+    auto found = has_avx2()
+                   ? find_avx2(first, n, value, done)
+                   : find_sse2(first, n, value, done);
+    if (found)
+      return found;
+  }
+#endif
+
+  auto last = first + n;
+  auto found = std::find(first + done, last, value);
+  return found == last ? nullptr : found;
+}
+
+// Counts the elements of [first, first + n) equal to value.
+template <std::equality_comparable T>
+auto count_value(const T* first, std::size_t n,
+                 const T& value) -> std::size_t {
+  std::size_t done = 0;
+  std::size_t count = 0;
+
+#ifdef LINEAR_SIMD_X86
+  if constexpr (BytewiseComparable<T>)
+    count = has_avx2() ? count_avx2(first, n, value, done)
+                       : count_sse2(first, n, value, done);
+#endif
+
+  auto last = first + n;
+  return count + static_cast<std::size_t>(
+                   std::count(first + done, last, value));
+}
+
+#endif // SIMD_HPP
@@ -0,0 +1,211 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// A snapshot is a header holding the element size and
+// count, followed by each element in the order the
+// container keeps them: front to rear, and bottom to top
+// for stacks. It can be read back by any container of the
+// same kind and element type.
+//
+// Trivially copyable elements are stored as their raw
+// bytes, which contiguous containers write and read in
+// bulk. Other types are stored one by one, through
+// serialize and deserialize functions found by ADL:
+//
+//   void serialize(SnapshotWriter auto&, const T&);
+//   auto deserialize(SnapshotReader auto&,
+//                    std::type_identity<T>) -> T;
+
+template <class W>
+concept SnapshotWriter =
+  requires(W& writer, std::span<const std::byte> bytes) {
+    writer(bytes);
+  };
+
+template <class R>
+concept SnapshotReader =
+  requires(R& reader, std::span<std::byte> bytes) {
+    reader(bytes);
+  };
+
+template <class T>
+concept BitwiseSnapshottable =
+  std::is_trivially_copyable_v<T>;
+
+// Reads a snapshot that is already in memory, e.g. a
+// mapped file.
+class SpanReader {
+public:
+  explicit SpanReader(
+    std::span<const std::byte> bytes) noexcept
+    : bytes_{bytes} {}
+
+  [[nodiscard]] auto remaining() const noexcept
+    -> std::size_t {
+    return bytes_.size();
+  }
+
+  void operator()(std::span<std::byte> out) {
+    if (out.size() > bytes_.size())
+      throw std::runtime_error{"snapshot is truncated"};
+    std::memcpy(out.data(), bytes_.data(), out.size());
+    bytes_ = bytes_.subspan(out.size());
+  }
+
+private:
+  std::span<const std::byte> bytes_;
+};
+
+template <BitwiseSnapshottable T>
+void write_values(SnapshotWriter auto& writer,
+                  const T* values, std::size_t n) {
+  if (n > 0)
+    writer(std::as_bytes(std::span{values, n}));
+}
+
+template <BitwiseSnapshottable T>
+void read_values(SnapshotReader auto& reader, T* values,
+                 std::size_t n) {
+  if (n > 0)
+    reader(std::as_writable_bytes(std::span{values, n}));
+}
+
+template <BitwiseSnapshottable T>
+auto read_value(SnapshotReader auto& reader) -> T {
+  std::array<std::byte, sizeof(T)> bytes;
+  reader(std::span{bytes});
+  return std::bit_cast<T>(bytes);
+}
+
+// Strings are stored as their length and characters.
+void serialize(SnapshotWriter auto& writer,
+               const std::string& value) {
+  std::uint64_t size = value.size();
+  write_values(writer, &size, 1);
+  write_values(writer, value.data(), value.size());
+}
+
+// Grows the string as the characters arrive, so that a
+// corrupt length runs out of input before it exhausts
+// memory.
+auto deserialize(SnapshotReader auto& reader,
+                 std::type_identity<std::string>)
+  -> std::string {
+  constexpr std::uint64_t chunk = 4096;
+  auto size = read_value<std::uint64_t>(reader);
+
+  std::string value;
+  while (size > 0) {
+    auto n =
+      static_cast<std::size_t>(std::min(size, chunk));
+    auto old = value.size();
+    value.resize(old + n);
+    read_values(reader, value.data() + old, n);
+    size -= n;
+  }
+  return value;
+}
+
+// Stand-ins for any writer and reader, to check that a
+// type has serialize and deserialize.
+struct AnySnapshotWriter {
+  void operator()(std::span<const std::byte>) const;
+};
+struct AnySnapshotReader {
+  void operator()(std::span<std::byte>) const;
+};
+
+template <class T>
+concept Serializable =
+  requires(AnySnapshotWriter& writer,
+           AnySnapshotReader& reader, const T& value) {
+    serialize(writer, value);
+    {
+      deserialize(reader, std::type_identity<T>{})
+    } -> std::same_as<T>;
+  };
+
+template <class T>
+concept Snapshottable =
+  BitwiseSnapshottable<T> or Serializable<T>;
+
+template <Snapshottable T>
+void write_element(SnapshotWriter auto& writer,
+                   const T& value) {
+  if constexpr (BitwiseSnapshottable<T>)
+    write_values(writer, &value, 1);
+  else
+    serialize(writer, value);
+}
+
+template <Snapshottable T>
+auto read_element(SnapshotReader auto& reader) -> T {
+  if constexpr (BitwiseSnapshottable<T>)
+    return read_value<T>(reader);
+  else
+    return deserialize(reader, std::type_identity<T>{});
+}
+
+struct SnapshotHeader {
+  // "LNSN" when stored little-endian.
+  static constexpr std::uint32_t current_magic = 0x4E534E4C;
+  static constexpr std::uint32_t current_version = 1;
+
+  std::uint32_t magic = current_magic;
+  std::uint32_t version = current_version;
+  std::uint64_t element_size;
+  std::uint64_t count;
+};
+
+template <Snapshottable T>
+void write_header(SnapshotWriter auto& writer,
+                  std::size_t count) {
+  SnapshotHeader header{.element_size = sizeof(T),
+                        .count = count};
+  write_values(writer, &header, 1);
+}
+
+// Returns the element count, after checking that the
+// header was written for elements of this size and that
+// the count fits in memory. For raw elements, readers
+// that know how much input is left, such as SpanReader,
+// also reject counts larger than it; otherwise a corrupt
+// count fails when the input runs out or the buffer cannot
+// be allocated.
+template <Snapshottable T>
+auto read_header(SnapshotReader auto& reader)
+  -> std::size_t {
+  auto header = read_value<SnapshotHeader>(reader);
+  if (header.magic != SnapshotHeader::current_magic)
+    throw std::runtime_error{"not a snapshot"};
+  if (header.version != SnapshotHeader::current_version)
+    throw std::runtime_error{
+      "unsupported snapshot version"};
+  if (header.element_size != sizeof(T))
+    throw std::runtime_error{
+      "snapshot element size does not match"};
+
+  if (header.count > SIZE_MAX / sizeof(T))
+    throw std::runtime_error{"snapshot count is too large"};
+  auto count = static_cast<std::size_t>(header.count);
+  if constexpr (BitwiseSnapshottable<T> and
+                requires { reader.remaining(); }) {
+    if (count > reader.remaining() / sizeof(T))
+      throw std::runtime_error{"snapshot is truncated"};
+  }
+  return count;
+}
+
+#endif // SNAPSHOT_HPP
@@ -1,12 +1,41 @@
 #ifndef STACK_CONTIGUOUS_HPP
 #define STACK_CONTIGUOUS_HPP
 
+#include "linear/page_allocator.hpp"
+#include "linear/simd.hpp"
+#include "linear/snapshot.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// The linked variant is linked::Stack.
+namespace contiguous {
 
 template <std::movable T>
-class Stack : private std::allocator<T> {
+class Stack : private PageAllocator<T> {
 public:
+  struct Options {
+    // When non-zero, growing only allocates the new buffer;
+    // each later push or pop then moves this many elements
+    // over until the old buffer is empty.
+    std::size_t migration_step = 0;
+
+    // When non-zero, the buffer is halved once at most
+    // 1/shrink_ratio of it is in use. Must be greater than
+    // 2 so that a halved buffer is never full, and at least
+    // 4 with a migration step, so that a shrink migration
+    // ends before the halved buffer can fill up.
+    std::size_t shrink_ratio = 0;
+  };
+
+  Stack() noexcept = default;
+  explicit Stack(Options);
   ~Stack() noexcept;
 
   void push(T);
@@ -14,22 +43,84 @@ public:
   [[nodiscard]] auto top() const -> const T&;
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  [[nodiscard]] auto try_pop() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] auto pop_value() -> T;
+
+  // Expect a non-empty stack, checked only by assert.
+  [[nodiscard]] auto unchecked_top() const noexcept
+    -> const T&;
+  void unchecked_pop() noexcept;
+
+  [[nodiscard]] auto capacity() const noexcept
+    -> std::size_t;
+
+  void shrink_to_fit();
+
+  [[nodiscard]] auto find(const T&) const -> const T*
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto find(
+    const std::predicate<const T&> auto&) const -> const T*;
+  [[nodiscard]] auto count(const T&) const -> std::size_t
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto count(
+    const std::predicate<const T&> auto&) const
+    -> std::size_t;
+  [[nodiscard]] auto contains(const T&) const -> bool
+    requires std::equality_comparable<T>;
+  [[nodiscard]] auto contains(
+    const std::predicate<const T&> auto&) const -> bool;
+
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   void double_capacity();
+  void resize(std::size_t);
+  void reallocate(std::size_t);
+  void begin_migration(std::size_t);
+  void migrate(std::size_t);
+  auto at(std::size_t) const noexcept -> T&;
+  void for_each_segment(auto&&) const;
 
   T* values_ = nullptr;
   std::size_t count_ = 0;
   std::size_t capacity_ = 0;
+
+  // Elements [0, pending_) still live in old_values_.
+  T* old_values_ = nullptr;
+  std::size_t old_capacity_ = 0;
+  std::size_t pending_ = 0;
+  std::size_t migration_step_ = 0;
+  std::size_t shrink_ratio_ = 0;
 };
 
+template <std::movable T>
+Stack<T>::Stack(Options options)
+  : migration_step_{options.migration_step},
+    shrink_ratio_{options.shrink_ratio} {
+  if (shrink_ratio_ == 1 or shrink_ratio_ == 2)
+    throw std::invalid_argument{"shrink ratio must be > 2"};
+  if (migration_step_ > 0 and shrink_ratio_ > 0 and
+      shrink_ratio_ < 4)
+    throw std::invalid_argument{
+      "shrink ratio must be >= 4 with a migration step"};
+}
+
 template <std::movable T>
 Stack<T>::~Stack() noexcept {
-  std::destroy_n(values_, count_);
+  std::destroy_n(old_values_, pending_);
+  std::destroy_n(values_ + pending_, count_ - pending_);
+  this->deallocate(old_values_, old_capacity_);
   this->deallocate(values_, capacity_);
 }
 
 template <std::movable T>
 void Stack<T>::push(T value) {
+  migrate(migration_step_);
   if (count_ == capacity_)
     double_capacity();
   new (values_ + count_) T(std::move(value));
@@ -40,15 +131,14 @@ template <std::movable T>
 void Stack<T>::pop() {
   if (is_empty())
     throw std::runtime_error{"no element to pop"};
-  --count_;
-  values_[count_].~T();
+  unchecked_pop();
 }
 
 template <std::movable T>
 auto Stack<T>::top() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty stack has no top"};
-  return values_[count_ - 1];
+  return unchecked_top();
 }
 
 template <std::movable T>
@@ -56,9 +146,174 @@ auto Stack<T>::is_empty() const noexcept -> bool {
   return count_ == 0;
 }
 
+template <std::movable T>
+auto Stack<T>::try_pop() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(at(count_ - 1))};
+  unchecked_pop();
+  return value;
+}
+
+// Moves the top out instead of copying it before the pop.
+template <std::movable T>
+auto Stack<T>::pop_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to pop"};
+  auto value = std::move(at(count_ - 1));
+  unchecked_pop();
+  return value;
+}
+
+template <std::movable T>
+auto Stack<T>::unchecked_top() const noexcept -> const T& {
+  assert(not is_empty());
+  return at(count_ - 1);
+}
+
+template <std::movable T>
+void Stack<T>::unchecked_pop() noexcept {
+  assert(not is_empty());
+  at(--count_).~T();
+  if (count_ < pending_)
+    pending_ = count_;
+
+  // The element is gone either way. Migrating and shrinking
+  // leave the stack unchanged when they throw, so a failure
+  // only defers them to a later operation.
+  try {
+    migrate(migration_step_);
+    if (shrink_ratio_ > 0 and pending_ == 0 and
+        capacity_ > 1 and
+        count_ * shrink_ratio_ <= capacity_)
+      resize(capacity_ / 2);
+  } catch (...) {
+  }
+}
+
+template <std::movable T>
+auto Stack<T>::capacity() const noexcept -> std::size_t {
+  return capacity_;
+}
+
+template <std::movable T>
+void Stack<T>::shrink_to_fit() {
+  if (count_ < capacity_)
+    reallocate(count_);
+}
+
+// Searches run over each contiguous segment in turn, from
+// bottom to top, and return the first match.
+template <std::movable T>
+auto Stack<T>::find(const T& value) const -> const T*
+  requires std::equality_comparable<T> {
+  const T* found = nullptr;
+  for_each_segment([&](const T* values, std::size_t n) {
+    if (not found)
+      found = find_value(values, n, value);
+  });
+  return found;
+}
+
+template <std::movable T>
+auto Stack<T>::find(
+  const std::predicate<const T&> auto& f) const
+  -> const T* {
+  const T* found = nullptr;
+  for_each_segment([&](const T* values, std::size_t n) {
+    if (not found) {
+      auto p = std::find_if(values, values + n, f);
+      found = p == values + n ? nullptr : p;
+    }
+  });
+  return found;
+}
+
+template <std::movable T>
+auto Stack<T>::count(const T& value) const -> std::size_t
+  requires std::equality_comparable<T> {
+  std::size_t count = 0;
+  for_each_segment([&](const T* values, std::size_t n) {
+    count += count_value(values, n, value);
+  });
+  return count;
+}
+
+template <std::movable T>
+auto Stack<T>::count(
+  const std::predicate<const T&> auto& f) const
+  -> std::size_t {
+  std::size_t count = 0;
+  for_each_segment([&](const T* values, std::size_t n) {
+    count += std::count_if(values, values + n, f);
+  });
+  return count;
+}
+
+template <std::movable T>
+auto Stack<T>::contains(const T& value) const -> bool
+  requires std::equality_comparable<T> {
+  return find(value) != nullptr;
+}
+
+template <std::movable T>
+auto Stack<T>::contains(
+  const std::predicate<const T&> auto& f) const -> bool {
+  return find(f) != nullptr;
+}
+
+template <std::movable T>
+void Stack<T>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  write_header<T>(writer, count_);
+  for_each_segment([&](const T* values, std::size_t n) {
+    if constexpr (BitwiseSnapshottable<T>)
+      write_values(writer, values, n);
+    else
+      for (std::size_t i = 0; i < n; ++i)
+        write_element(writer, values[i]);
+  });
+}
+
+// Raw elements are read straight into the buffer; others
+// are pushed one by one as they are deserialized.
+
+template <std::movable T>
+void Stack<T>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  auto count = read_header<T>(reader);
+  if constexpr (BitwiseSnapshottable<T>) {
+    if (count > SIZE_MAX / sizeof(T) - count_)
+      throw std::runtime_error{
+        "snapshot count is too large"};
+    if (count_ + count > capacity_)
+      reallocate(count_ + count);
+    read_values(reader, values_ + count_, count);
+    count_ += count;
+  } else {
+    for (; count > 0; --count)
+      push(read_element<T>(reader));
+  }
+}
+
 template <std::movable T>
 void Stack<T>::double_capacity() {
-  auto new_capacity = capacity_ == 0 ? 1 : 2 * capacity_;
+  resize(capacity_ == 0 ? 1 : 2 * capacity_);
+}
+
+template <std::movable T>
+void Stack<T>::resize(std::size_t new_capacity) {
+  if (migration_step_ > 0 and count_ > 0)
+    begin_migration(new_capacity);
+  else
+    reallocate(new_capacity);
+}
+
+template <std::movable T>
+void Stack<T>::reallocate(std::size_t new_capacity) {
+  migrate(pending_);
   auto buffer = this->allocate(new_capacity);
 
   if constexpr (std::is_nothrow_move_constructible_v<T>)
@@ -77,4 +332,46 @@ void Stack<T>::double_capacity() {
   capacity_ = new_capacity;
 }
 
+template <std::movable T>
+void Stack<T>::begin_migration(std::size_t new_capacity) {
+  migrate(pending_);
+  auto buffer = this->allocate(new_capacity);
+
+  old_values_ = std::exchange(values_, buffer);
+  old_capacity_ = std::exchange(capacity_, new_capacity);
+  pending_ = count_;
+}
+
+// Moves up to n elements out of the old buffer, top first.
+template <std::movable T>
+void Stack<T>::migrate(std::size_t n) {
+  for (; n > 0 and pending_ > 0; --n) {
+    new (values_ + pending_ - 1)
+      T(std::move_if_noexcept(old_values_[pending_ - 1]));
+    old_values_[--pending_].~T();
+  }
+
+  if (pending_ == 0 and old_values_) {
+    this->deallocate(old_values_, old_capacity_);
+    old_values_ = nullptr;
+    old_capacity_ = 0;
+  }
+}
+
+template <std::movable T>
+auto Stack<T>::at(std::size_t i) const noexcept -> T& {
+  return i < pending_ ? old_values_[i] : values_[i];
+}
+
+// Calls f(pointer, count) for each contiguous run of
+// elements, from bottom to top.
+template <std::movable T>
+void Stack<T>::for_each_segment(auto&& f) const {
+  f(static_cast<const T*>(old_values_), pending_);
+  f(static_cast<const T*>(values_ + pending_),
+    count_ - pending_);
+}
+
+} // namespace contiguous
+
 #endif // STACK_CONTIGUOUS_HPP
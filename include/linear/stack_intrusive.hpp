@@ -0,0 +1,75 @@
+#ifndef STACK_INTRUSIVE_HPP
+#define STACK_INTRUSIVE_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+// Stacks objects owned elsewhere through their own `Next`
+// member; nothing is allocated or copied.
+template <class T, T* T::*Next>
+class IntrusiveStack {
+public:
+  void push(T&) noexcept;
+  void pop();
+  [[nodiscard]] auto top() const -> T&;
+  [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+  // Returns nullptr when the stack is empty.
+  auto try_pop() noexcept -> T*;
+
+  // Expect a non-empty stack, checked only by assert.
+  [[nodiscard]] auto unchecked_top() const noexcept -> T&;
+  void unchecked_pop() noexcept;
+
+private:
+  T* top_ = nullptr;
+};
+
+template <class T, T* T::*Next>
+void IntrusiveStack<T, Next>::push(T& value) noexcept {
+  value.*Next = std::exchange(top_, &value);
+}
+
+template <class T, T* T::*Next>
+void IntrusiveStack<T, Next>::pop() {
+  if (is_empty())
+    throw std::runtime_error{"no element to pop"};
+  unchecked_pop();
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveStack<T, Next>::top() const -> T& {
+  if (is_empty())
+    throw std::runtime_error{"empty stack has no top"};
+  return unchecked_top();
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveStack<T, Next>::is_empty() const noexcept
+  -> bool {
+  return top_ == nullptr;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveStack<T, Next>::try_pop() noexcept -> T* {
+  auto top = top_;
+  if (top)
+    unchecked_pop();
+  return top;
+}
+
+template <class T, T* T::*Next>
+auto IntrusiveStack<T, Next>::unchecked_top() const noexcept
+  -> T& {
+  assert(not is_empty());
+  return *top_;
+}
+
+template <class T, T* T::*Next>
+void IntrusiveStack<T, Next>::unchecked_pop() noexcept {
+  assert(not is_empty());
+  top_ = std::exchange(top_->*Next, nullptr);
+}
+
+#endif // STACK_INTRUSIVE_HPP
@@ -1,8 +1,17 @@
 #ifndef STACK_LINKED_HPP
 #define STACK_LINKED_HPP
 
+#include "linear/snapshot.hpp"
+
+#include <cassert>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+// The contiguous variant is contiguous::Stack.
+namespace linked {
 
 template <std::movable T>
 class Stack {
@@ -14,6 +23,21 @@ public:
   [[nodiscard]] auto top() const -> const T&;
   [[nodiscard]] auto is_empty() const noexcept -> bool;
 
+  [[nodiscard]] auto try_pop() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] auto pop_value() -> T;
+
+  // Expect a non-empty stack, checked only by assert.
+  [[nodiscard]] auto unchecked_top() const noexcept
+    -> const T&;
+  void unchecked_pop() noexcept;
+
+  void save(SnapshotWriter auto&&) const
+    requires Snapshottable<T>;
+  void load(SnapshotReader auto&&)
+    requires Snapshottable<T>;
+
 private:
   struct Node {
     T value;
@@ -38,14 +62,14 @@ template <std::movable T>
 void Stack<T>::pop() {
   if (is_empty())
     throw std::runtime_error{"no element to pop"};
-  delete std::exchange(top_, top_->next);
+  unchecked_pop();
 }
 
 template <std::movable T>
 auto Stack<T>::top() const -> const T& {
   if (is_empty())
     throw std::runtime_error{"empty stack has no top"};
-  return top_->value;
+  return unchecked_top();
 }
 
 template <std::movable T>
@@ -53,4 +77,80 @@ auto Stack<T>::is_empty() const noexcept -> bool {
   return top_ == nullptr;
 }
 
+template <std::movable T>
+auto Stack<T>::try_pop() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(top_->value)};
+  unchecked_pop();
+  return value;
+}
+
+// Moves the top out instead of copying it before the pop.
+template <std::movable T>
+auto Stack<T>::pop_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to pop"};
+  auto value = std::move(top_->value);
+  unchecked_pop();
+  return value;
+}
+
+template <std::movable T>
+auto Stack<T>::unchecked_top() const noexcept -> const T& {
+  assert(not is_empty());
+  return top_->value;
+}
+
+template <std::movable T>
+void Stack<T>::unchecked_pop() noexcept {
+  assert(not is_empty());
+  delete std::exchange(top_, top_->next);
+}
+
+// Elements are saved from bottom to top, like the
+// contiguous Stack does, so the list is walked once to
+// collect them in reverse.
+template <std::movable T>
+void Stack<T>::save(SnapshotWriter auto&& writer) const
+  requires Snapshottable<T> {
+  std::vector<const T*> values;
+  for (auto p = top_; p; p = p->next)
+    values.push_back(&p->value);
+
+  write_header<T>(writer, values.size());
+  for (auto i = values.size(); i > 0; --i)
+    write_element(writer, *values[i - 1]);
+}
+
+template <std::movable T>
+void Stack<T>::load(SnapshotReader auto&& reader)
+  requires Snapshottable<T> {
+  auto count = read_header<T>(reader);
+  if (count == 0)
+    return;
+
+  // Built apart, so that a failed load leaves the stack
+  // unchanged.
+  Node* top = nullptr;
+  Node* bottom = nullptr;
+  try {
+    bottom = top =
+      new Node{read_element<T>(reader), nullptr};
+    for (; count > 1; --count)
+      top = new Node{read_element<T>(reader), top};
+  } catch (...) {
+    while (top)
+      delete std::exchange(top, top->next);
+    throw;
+  }
+
+  bottom->next = top_;
+  top_ = top;
+}
+
+} // namespace linked
+
 #endif // STACK_LINKED_HPP
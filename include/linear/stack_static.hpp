@@ -0,0 +1,115 @@
+#ifndef STACK_STATIC_HPP
+#define STACK_STATIC_HPP
+
+#include "linear/static_storage.hpp"
+
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+template <std::movable T, std::size_t N>
+class StaticStack {
+public:
+  constexpr StaticStack() noexcept {}
+  constexpr ~StaticStack() noexcept;
+
+  [[nodiscard]] constexpr auto push(T) -> bool;
+  constexpr void pop();
+  [[nodiscard]] constexpr auto top() const -> const T&;
+  [[nodiscard]] constexpr auto is_empty() const noexcept
+    -> bool;
+  [[nodiscard]] constexpr auto is_full() const noexcept
+    -> bool;
+
+  [[nodiscard]] constexpr auto try_pop() noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    -> std::optional<T>;
+  [[nodiscard]] constexpr auto pop_value() -> T;
+
+  // Expect a non-empty stack, checked only by assert.
+  [[nodiscard]] constexpr auto unchecked_top()
+    const noexcept -> const T&;
+  constexpr void unchecked_pop() noexcept;
+
+private:
+  StaticStorage<T, N> values_;
+  std::size_t count_ = 0;
+};
+
+template <std::movable T, std::size_t N>
+constexpr StaticStack<T, N>::~StaticStack() noexcept {
+  for (std::size_t i = 0; i < count_; ++i)
+    values_.destroy(i);
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::push(T value) -> bool {
+  if (is_full())
+    return false;
+  values_.construct(count_, std::move(value));
+  ++count_;
+  return true;
+}
+
+template <std::movable T, std::size_t N>
+constexpr void StaticStack<T, N>::pop() {
+  if (is_empty())
+    throw std::runtime_error{"no element to pop"};
+  unchecked_pop();
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::top() const -> const T& {
+  if (is_empty())
+    throw std::runtime_error{"empty stack has no top"};
+  return unchecked_top();
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::is_empty() const noexcept
+  -> bool {
+  return count_ == 0;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::is_full() const noexcept
+  -> bool {
+  return count_ == N;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::try_pop() noexcept(
+  std::is_nothrow_move_constructible_v<T>)
+  -> std::optional<T> {
+  if (is_empty())
+    return std::nullopt;
+  std::optional<T> value{std::move(values_[count_ - 1])};
+  unchecked_pop();
+  return value;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::pop_value() -> T {
+  if (is_empty())
+    throw std::runtime_error{"no element to pop"};
+  auto value = std::move(values_[count_ - 1]);
+  unchecked_pop();
+  return value;
+}
+
+template <std::movable T, std::size_t N>
+constexpr auto StaticStack<T, N>::unchecked_top()
+  const noexcept -> const T& {
+  assert(not is_empty());
+  return values_[count_ - 1];
+}
+
+template <std::movable T, std::size_t N>
+constexpr void StaticStack<T, N>::unchecked_pop() noexcept {
+  assert(not is_empty());
+  --count_;
+  values_.destroy(count_);
+}
+
+#endif // STACK_STATIC_HPP
@@ -0,0 +1,69 @@
+#ifndef STATIC_STORAGE_HPP
+#define STATIC_STORAGE_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+concept TriviallyStorable =
+  std::is_trivially_default_constructible_v<T> and
+  std::is_trivially_copyable_v<T>;
+
+// Room for N elements inside the object. Elements are only
+// constructed when inserted, so T needs no default
+// constructor.
+template <class T, std::size_t N>
+class StaticStorage {
+public:
+  constexpr StaticStorage() noexcept {}
+  constexpr ~StaticStorage() noexcept {}
+
+  constexpr void construct(std::size_t i, T value) {
+    std::construct_at(values_ + i, std::move(value));
+  }
+  constexpr void destroy(std::size_t i) noexcept {
+    std::destroy_at(values_ + i);
+  }
+
+  constexpr auto operator[](std::size_t i) noexcept -> T& {
+    return values_[i];
+  }
+  constexpr auto operator[](std::size_t i) const noexcept
+    -> const T& {
+    return values_[i];
+  }
+
+private:
+  union {
+    T values_[N];
+  };
+};
+
+// Trivial elements live in a value-initialised array, so
+// that a container holding them is fully initialised and
+// can be a constexpr or constinit variable. Ending their
+// lifetime would leave it partly uninitialised, so free
+// slots keep their last value instead.
+template <class T, std::size_t N>
+  requires TriviallyStorable<T>
+class StaticStorage<T, N> {
+public:
+  constexpr void construct(std::size_t i, T value) noexcept {
+    values_[i] = value;
+  }
+  constexpr void destroy(std::size_t) noexcept {}
+
+  constexpr auto operator[](std::size_t i) noexcept -> T& {
+    return values_[i];
+  }
+  constexpr auto operator[](std::size_t i) const noexcept
+    -> const T& {
+    return values_[i];
+  }
+
+private:
+  T values_[N]{};
+};
+
+#endif // STATIC_STORAGE_HPP
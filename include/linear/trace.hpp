@@ -0,0 +1,459 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "linear/snapshot.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// A compact log of stack, queue or deque operations, meant
+// to be captured from real traffic and replayed against
+// other implementations. Each operation is one varint
+// holding the element size (zero unless inserting) shifted
+// past a 4-bit code, so removals and peeks take one byte.
+class Trace {
+public:
+  enum class Op : std::uint8_t {
+    push,
+    pop,
+    top,
+    enqueue,
+    dequeue,
+    front,
+    insert_front,
+    insert_rear,
+    remove_front,
+    remove_rear,
+    rear,
+  };
+
+  struct Event {
+    Op op;
+    std::size_t size;
+  };
+
+  void record(Op, std::size_t size = 0);
+  void for_each(auto&&) const;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+  [[nodiscard]] auto bytes() const noexcept -> std::size_t;
+
+  void save(SnapshotWriter auto&&) const;
+  void load(SnapshotReader auto&&);
+
+private:
+  static void check(const std::uint8_t*, std::size_t n,
+                    std::size_t size);
+
+  std::vector<std::uint8_t> bytes_;
+  std::size_t size_ = 0;
+};
+
+inline void Trace::record(Op op, std::size_t size) {
+  auto word = static_cast<std::uint64_t>(size) << 4 |
+              static_cast<std::uint64_t>(op);
+  for (; word >= 0x80; word >>= 7)
+    bytes_.push_back(
+      static_cast<std::uint8_t>(word | 0x80));
+  bytes_.push_back(static_cast<std::uint8_t>(word));
+  ++size_;
+}
+
+// Calls f(Event) for each operation, oldest first.
+void Trace::for_each(auto&& f) const {
+  std::uint64_t word = 0;
+  int shift = 0;
+  for (auto byte : bytes_) {
+    word |= std::uint64_t{byte & 0x7Fu} << shift;
+    shift += 7;
+    if (byte & 0x80)
+      continue;
+
+    f(Event{static_cast<Op>(word & 15),
+            static_cast<std::size_t>(word >> 4)});
+    word = 0;
+    shift = 0;
+  }
+}
+
+inline auto Trace::size() const noexcept -> std::size_t {
+  return size_;
+}
+
+inline auto Trace::bytes() const noexcept -> std::size_t {
+  return bytes_.size();
+}
+
+// Saved as a snapshot of the encoded bytes, with the
+// operation count between the header and the bytes.
+void Trace::save(SnapshotWriter auto&& writer) const {
+  write_header<std::uint8_t>(writer, bytes_.size());
+  write_values(writer, &size_, 1);
+  write_values(writer, bytes_.data(), bytes_.size());
+}
+
+// Appends the loaded operations to the trace. They are
+// checked first, since for_each trusts its bytes.
+void Trace::load(SnapshotReader auto&& reader) {
+  auto count = read_header<std::uint8_t>(reader);
+  auto size = read_value<std::size_t>(reader);
+
+  auto old = bytes_.size();
+  bytes_.resize(old + count);
+  try {
+    read_values(reader, bytes_.data() + old, count);
+    check(bytes_.data() + old, count, size);
+  } catch (...) {
+    bytes_.resize(old);
+    throw;
+  }
+  size_ += size;
+}
+
+// Throws unless the n bytes are exactly size operations,
+// each a varint of at most 10 bytes that fits 64 bits and
+// holds a known code.
+inline void Trace::check(const std::uint8_t* bytes,
+                         std::size_t n, std::size_t size) {
+  constexpr auto last = static_cast<unsigned>(Op::rear);
+
+  std::size_t decoded = 0;
+  std::size_t length = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto byte = bytes[i];
+    if (length == 0 and (byte & 15u) > last)
+      throw std::runtime_error{"unknown trace operation"};
+    if (++length == 10 and byte > 1)
+      throw std::runtime_error{
+        "trace operation is too long"};
+    if (byte & 0x80)
+      continue;
+
+    ++decoded;
+    length = 0;
+  }
+
+  if (length > 0)
+    throw std::runtime_error{
+      "trace ends inside an operation"};
+  if (decoded != size)
+    throw std::runtime_error{
+      "trace operation count does not match"};
+}
+
+// Size logged for an inserted element: its length when it
+// has one, such as a string, or its object size otherwise.
+auto traced_size(const auto& value) -> std::size_t {
+  if constexpr (requires { std::size(value); })
+    return std::size(value);
+  else
+    return sizeof(value);
+}
+
+// Wraps a Stack, Queue or Deque and logs its element
+// operations. Only the recorded operations and is_empty()
+// are exposed, so no operation can bypass the trace.
+// Queue and Deque share the front peek.
+template <class C>
+class Recorded : private C {
+public:
+  using C::C;
+  using C::is_empty;
+
+  auto push(auto&& value) -> decltype(auto)
+    requires requires(C& c) {
+      c.push(std::forward<decltype(value)>(value));
+    } {
+    trace_.record(Trace::Op::push, traced_size(value));
+    return C::push(std::forward<decltype(value)>(value));
+  }
+
+  auto pop() -> decltype(auto)
+    requires requires(C& c) { c.pop(); } {
+    trace_.record(Trace::Op::pop);
+    return C::pop();
+  }
+
+  auto try_pop() -> decltype(auto)
+    requires requires(C& c) { c.try_pop(); } {
+    trace_.record(Trace::Op::pop);
+    return C::try_pop();
+  }
+
+  auto pop_value() -> decltype(auto)
+    requires requires(C& c) { c.pop_value(); } {
+    trace_.record(Trace::Op::pop);
+    return C::pop_value();
+  }
+
+  auto top() const -> decltype(auto)
+    requires requires(const C& c) { c.top(); } {
+    trace_.record(Trace::Op::top);
+    return C::top();
+  }
+
+  auto enqueue(auto&& value) -> decltype(auto)
+    requires requires(C& c) {
+      c.enqueue(std::forward<decltype(value)>(value));
+    } {
+    trace_.record(Trace::Op::enqueue, traced_size(value));
+    return C::enqueue(std::forward<decltype(value)>(value));
+  }
+
+  auto dequeue() -> decltype(auto)
+    requires requires(C& c) { c.dequeue(); } {
+    trace_.record(Trace::Op::dequeue);
+    return C::dequeue();
+  }
+
+  auto try_dequeue() -> decltype(auto)
+    requires requires(C& c) { c.try_dequeue(); } {
+    trace_.record(Trace::Op::dequeue);
+    return C::try_dequeue();
+  }
+
+  auto dequeue_value() -> decltype(auto)
+    requires requires(C& c) { c.dequeue_value(); } {
+    trace_.record(Trace::Op::dequeue);
+    return C::dequeue_value();
+  }
+
+  auto front() const -> decltype(auto)
+    requires requires(const C& c) { c.front(); } {
+    trace_.record(Trace::Op::front);
+    return C::front();
+  }
+
+  auto insert_front(auto&& value) -> decltype(auto)
+    requires requires(C& c) {
+      c.insert_front(std::forward<decltype(value)>(value));
+    } {
+    trace_.record(Trace::Op::insert_front,
+                  traced_size(value));
+    return C::insert_front(
+      std::forward<decltype(value)>(value));
+  }
+
+  auto insert_rear(auto&& value) -> decltype(auto)
+    requires requires(C& c) {
+      c.insert_rear(std::forward<decltype(value)>(value));
+    } {
+    trace_.record(Trace::Op::insert_rear,
+                  traced_size(value));
+    return C::insert_rear(
+      std::forward<decltype(value)>(value));
+  }
+
+  auto remove_front() -> decltype(auto)
+    requires requires(C& c) { c.remove_front(); } {
+    trace_.record(Trace::Op::remove_front);
+    return C::remove_front();
+  }
+
+  auto try_remove_front() -> decltype(auto)
+    requires requires(C& c) { c.try_remove_front(); } {
+    trace_.record(Trace::Op::remove_front);
+    return C::try_remove_front();
+  }
+
+  auto remove_front_value() -> decltype(auto)
+    requires requires(C& c) { c.remove_front_value(); } {
+    trace_.record(Trace::Op::remove_front);
+    return C::remove_front_value();
+  }
+
+  auto remove_rear() -> decltype(auto)
+    requires requires(C& c) { c.remove_rear(); } {
+    trace_.record(Trace::Op::remove_rear);
+    return C::remove_rear();
+  }
+
+  auto try_remove_rear() -> decltype(auto)
+    requires requires(C& c) { c.try_remove_rear(); } {
+    trace_.record(Trace::Op::remove_rear);
+    return C::try_remove_rear();
+  }
+
+  auto remove_rear_value() -> decltype(auto)
+    requires requires(C& c) { c.remove_rear_value(); } {
+    trace_.record(Trace::Op::remove_rear);
+    return C::remove_rear_value();
+  }
+
+  auto rear() const -> decltype(auto)
+    requires requires(const C& c) { c.rear(); } {
+    trace_.record(Trace::Op::rear);
+    return C::rear();
+  }
+
+  [[nodiscard]] auto trace() const noexcept
+    -> const Trace& {
+    return trace_;
+  }
+
+private:
+  mutable Trace trace_;
+};
+
+// Applies one event to a container of this library or to
+// a std:: container or adaptor, building inserted values
+// with make(size). Each operation uses the member of the
+// same name when there is one, so std::queue::push serves
+// an enqueue and std::deque::push_front an insert_front.
+// Removals and peeks on an empty container are skipped, as
+// they failed when recorded.
+template <class C>
+void apply(C& container, Trace::Event event, auto&& make) {
+  bool empty;
+  if constexpr (requires { container.is_empty(); })
+    empty = container.is_empty();
+  else
+    empty = container.empty();
+
+  auto unsupported = [] {
+    throw std::runtime_error{
+      "trace operation not supported by the container"};
+  };
+
+  switch (event.op) {
+  case Trace::Op::push:
+    if constexpr (requires { container.push(make(0)); })
+      (void)container.push(make(event.size));
+    else if constexpr (requires {
+                         container.enqueue(make(0));
+                       })
+      (void)container.enqueue(make(event.size));
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::enqueue:
+    if constexpr (requires { container.enqueue(make(0)); })
+      (void)container.enqueue(make(event.size));
+    else if constexpr (requires {
+                         container.push(make(0));
+                       })
+      (void)container.push(make(event.size));
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::insert_front:
+    if constexpr (requires {
+                    container.insert_front(make(0));
+                  })
+      (void)container.insert_front(make(event.size));
+    else if constexpr (requires {
+                         container.push_front(make(0));
+                       })
+      (void)container.push_front(make(event.size));
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::insert_rear:
+    if constexpr (requires {
+                    container.insert_rear(make(0));
+                  })
+      (void)container.insert_rear(make(event.size));
+    else if constexpr (requires {
+                         container.push_back(make(0));
+                       })
+      (void)container.push_back(make(event.size));
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::pop:
+    if (empty)
+      break;
+    if constexpr (requires { container.pop(); })
+      container.pop();
+    else if constexpr (requires { container.dequeue(); })
+      container.dequeue();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::dequeue:
+    if (empty)
+      break;
+    if constexpr (requires { container.dequeue(); })
+      container.dequeue();
+    else if constexpr (requires { container.pop(); })
+      container.pop();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::remove_front:
+    if (empty)
+      break;
+    if constexpr (requires { container.remove_front(); })
+      container.remove_front();
+    else if constexpr (requires { container.pop_front(); })
+      container.pop_front();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::remove_rear:
+    if (empty)
+      break;
+    if constexpr (requires { container.remove_rear(); })
+      container.remove_rear();
+    else if constexpr (requires { container.pop_back(); })
+      container.pop_back();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::top:
+    if (empty)
+      break;
+    if constexpr (requires { container.top(); })
+      (void)container.top();
+    else if constexpr (requires { container.front(); })
+      (void)container.front();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::front:
+    if (empty)
+      break;
+    if constexpr (requires { container.front(); })
+      (void)container.front();
+    else if constexpr (requires { container.top(); })
+      (void)container.top();
+    else
+      unsupported();
+    break;
+
+  case Trace::Op::rear:
+    if (empty)
+      break;
+    if constexpr (requires { container.rear(); })
+      (void)container.rear();
+    else if constexpr (requires { container.back(); })
+      (void)container.back();
+    else
+      unsupported();
+    break;
+
+  default:
+    throw std::runtime_error{"unknown trace operation"};
+  }
+}
+
+template <class C>
+void replay(const Trace& trace, C& container, auto&& make) {
+  trace.for_each([&](Trace::Event event) {
+    apply(container, event, make);
+  });
+}
+
+#endif // TRACE_HPP
@@ -0,0 +1,58 @@
+#include "linear/channel.hpp"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+struct Task {
+  struct promise_type {
+    auto get_return_object() noexcept -> Task { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+auto producer(Channel<std::string>& channel) -> Task {
+  for (auto name : {"foo", "bar", "baz"}) {
+    std::cout << "sending " << name << "\n";
+    co_await channel.send(name);
+  }
+}
+
+auto consumer(Channel<std::string>& channel, int n) -> Task {
+  for (; n > 0; --n)
+    std::cout << "received " << co_await channel.receive() << "\n";
+}
+
+static_assert(not std::is_copy_constructible_v<Channel<int>>);
+static_assert(not std::is_move_constructible_v<Channel<int>>);
+static_assert(not std::is_move_assignable_v<Channel<int>>);
+
+int main() {
+  {
+    Channel<std::string> channel;
+    consumer(channel, 3);
+    producer(channel);
+  }
+
+  {
+    Channel<std::string> channel(2);
+    producer(channel);
+    consumer(channel, 3);
+  }
+
+  {
+    Channel<std::string> channel(100);
+    for (std::size_t i = 0; i < 100; ++i)
+      [](auto& channel) -> Task {
+        co_await channel.send("very big string, probably will allocate memory...");
+      }(channel);
+    [](auto& channel) -> Task {
+      while (not channel.is_empty())
+        co_await channel.receive();
+    }(channel);
+  }
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 
 int main() {
   Colony<std::string> colony(4);
@@ -69,4 +70,21 @@ int main() {
     c.search([](int i) { std::cout << " " << i; return false; });
     std::cout << "\n";
   }
+
+  {
+    struct ByName {
+      auto operator()(const std::string& name) const noexcept -> const std::string& { return name; }
+    };
+
+    Colony<std::string, ByName> registry;
+    for (auto name : {"foo", "bar", "baz", "hello", "world"})
+      registry.insert(name);
+
+    // find() takes the key type, so "baz" becomes a string
+    // before the noexcept lookup.
+    static_assert(std::is_same_v<decltype(registry)::Key, std::string>);
+    registry.remove(registry.find("baz"));
+    std::cout << "Found " << *registry.find("hello") << "!\n";
+    std::cout << (registry.find("baz") ? "baz still indexed" : "baz removed") << "\n";
+  }
 }
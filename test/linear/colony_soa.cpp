@@ -0,0 +1,83 @@
+#include "linear/colony_soa.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+struct Body {
+  float position;
+  float velocity;
+  float mass;
+  std::string name;
+};
+
+// Throws when moved while armed, to fail an insert after
+// the earlier columns are built.
+struct Fragile {
+  static inline bool armed = false;
+
+  Fragile() = default;
+  Fragile(const Fragile&) = default;
+  Fragile(Fragile&&) {
+    if (armed)
+      throw std::runtime_error{"fragile move"};
+  }
+  auto operator=(const Fragile&) -> Fragile& = default;
+  auto operator=(Fragile&&) -> Fragile& = default;
+};
+
+struct Tagged {
+  std::string name;
+  Fragile fragile;
+};
+
+int main() {
+  SoaColony<Body, &Body::position, &Body::velocity, &Body::mass, &Body::name> bodies(2);
+
+  if (bodies.is_empty())
+    std::cout << "Colony is empty\n";
+
+  auto earth = bodies.insert({0.f, 1.f, 6.f, "earth"});
+  auto moon = bodies.insert({1.f, 2.f, 1.f, "moon"});
+  bodies.insert({2.f, 3.f, 2.f, "mars"});
+
+  std::cout << "Removing " << bodies.get<&Body::name>(moon) << "\n";
+  bodies.remove(moon);
+  bodies.insert({5.f, -1.f, 3.f, "comet"});
+
+  for (int step = 0; step < 3; ++step)
+    bodies.for_each<&Body::position, &Body::velocity>(
+      [](float& position, float velocity) { position += velocity; });
+
+  std::cout << "Colony contains values:";
+  bodies.for_each<&Body::name, &Body::position>(
+    [](const std::string& name, float position) {
+      std::cout << " " << name << "@" << position;
+    });
+  std::cout << "\n";
+
+  auto copy = bodies.value(earth);
+  std::cout << copy.name << " is at " << copy.position << " with mass " << copy.mass << "\n";
+
+  for (std::size_t i = 0; i < 100; ++i)
+    bodies.insert({0.f, 0.f, 0.f, "very big string, probably will allocate memory..."});
+
+  const auto& view = bodies;
+  static_assert(std::is_same_v<
+                decltype(view.get<&Body::name>(earth)),
+                const std::string&>);
+
+  SoaColony<Tagged, &Tagged::name, &Tagged::fragile> tagged;
+  auto kept = tagged.insert({"kept", {}});
+  tagged.remove(tagged.insert({"removed", {}}));
+  try {
+    Fragile::armed = true;
+    tagged.insert({"a name long enough to allocate", {}});
+  } catch (const std::runtime_error& e) {
+    std::cout << "insert failed: " << e.what() << "\n";
+  }
+  Fragile::armed = false;
+  auto reused = tagged.insert({"reused", {}});
+  std::cout << tagged.get<&Tagged::name>(kept) << " "
+            << tagged.get<&Tagged::name>(reused) << "\n";
+}
@@ -2,6 +2,10 @@
 
 #include <string>
 #include <iostream>
+#include <utility>
+
+static_assert(noexcept(std::declval<Deque<int>&>().try_remove_front()));
+static_assert(noexcept(std::declval<Deque<int>&>().try_remove_rear()));
 
 int main() {
   Deque<std::string> deque;
@@ -16,6 +20,9 @@ int main() {
   std::cout << deque.rear() << "\n";
   deque.remove_rear();
 
+  std::cout << deque.remove_front_value() << "\n";
+  std::cout << (deque.try_remove_rear() ? "removed" : "empty") << "\n";
+
   for (std::size_t i = 0; i < 100; ++i)
     deque.insert_rear({});
 }
@@ -0,0 +1,38 @@
+#include "linear/hash_index.hpp"
+
+#include <iostream>
+#include <vector>
+
+struct Entry {
+  int id;
+};
+
+struct ById {
+  auto operator()(const Entry& entry) const noexcept { return entry.id; }
+};
+
+int main() {
+  std::vector<Entry> entries;
+  for (int i = 0; i < 1000; ++i)
+    entries.push_back({i});
+
+  HashIndex<Entry, ById> index;
+  for (auto& entry : entries)
+    index.insert(&entry);
+
+  for (std::size_t i = 0; i < entries.size(); i += 2)
+    index.erase(&entries[i]);
+
+  std::size_t found = 0;
+  for (int i = 0; i < 1000; ++i)
+    if (auto entry = index.find(i)) {
+      if (entry->id != i or i % 2 == 0)
+        std::cout << "wrong entry for " << i << "\n";
+      ++found;
+    }
+
+  std::cout << "found " << found << " of " << index.size() << "\n";
+
+  index.clear();
+  std::cout << (index.find(1) ? "not cleared" : "cleared") << "\n";
+}
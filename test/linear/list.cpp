@@ -2,6 +2,18 @@
 
 #include <string>
 #include <iostream>
+#include <utility>
+
+struct Account {
+  int id;
+  std::string owner;
+};
+
+struct ById {
+  auto operator()(const Account& account) const noexcept { return account.id; }
+};
+
+static_assert(noexcept(std::declval<List<int>&>().try_remove_after(nullptr)));
 
 int main() {
   List<std::string> list;
@@ -19,4 +31,21 @@ int main() {
 
   for (std::size_t i = 0; i < 100; ++i)
     list.insert_after(list.before_first(), {});
+
+  List<Account, ById> accounts;
+  for (int id = 0; id < 100; ++id)
+    accounts.insert_after(accounts.last(), {id, "owner " + std::to_string(id)});
+
+  auto tail = accounts.split_after(accounts.find(49));
+  std::cout << accounts.find(42)->value().owner << "\n";
+  std::cout << (accounts.find(50) ? "still indexed" : "moved") << "\n";
+  std::cout << tail.find(50)->value().owner << "\n";
+
+  accounts.concatenate(tail);
+  accounts.remove_after(accounts.find(49));
+  std::cout << (accounts.find(50) ? "still indexed" : "removed") << "\n";
+
+  auto account = accounts.remove_after_value(accounts.find(49));
+  std::cout << account.owner << (accounts.find(51) ? " still indexed" : " removed") << "\n";
+  std::cout << accounts.find(99)->value().owner << "\n";
 }
@@ -0,0 +1,48 @@
+#include "linear/list_intrusive.hpp"
+
+#include <string>
+#include <iostream>
+
+struct Task {
+  std::string name;
+  Task* next = nullptr;
+};
+
+using Tasks = IntrusiveList<Task, &Task::next>;
+
+void print(const char* label, const Tasks& list) {
+  std::cout << label << ":";
+  for (auto p = list.next(list.before_first()); p != nullptr; p = list.next(p))
+    std::cout << " " << p->name;
+  std::cout << '\n';
+}
+
+int main() {
+  Task foo{"Foo"}, bar{"Bar"}, baz{"Baz"}, qux{"Qux"}, quux{"Quux"};
+
+  Tasks list;
+  auto p = list.insert_after(list.before_first(), bar);
+  list.insert_after(p, baz);
+  list.insert_after(list.before_first(), foo);
+  print("content", list);
+
+  Tasks other;
+  other.insert_after(other.last(), qux);
+  other.insert_after(other.last(), quux);
+  auto after = list.graft_after(&foo, other);
+  print("grafted", list);
+  std::cout << "after graft: " << after->name << "\n";
+
+  auto middle = list.extract_between(&foo, &quux);
+  print("extracted", middle);
+  print("remaining", list);
+
+  auto tail = list.split_after(&foo);
+  list.concatenate(middle);
+  print("rejoined", list);
+  print("tail", tail);
+
+  std::cout << "removed " << tail.remove_after(tail.before_first())->name << "\n";
+  auto found = list.search([](const Task& task) { return task.name == "Qux"; });
+  std::cout << "found " << found->name << "\n";
+}
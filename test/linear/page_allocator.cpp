@@ -0,0 +1,62 @@
+#include "linear/page_allocator.hpp"
+
+#include "linear/colony.hpp"
+#include "linear/stack_contiguous.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+
+using contiguous::Stack;
+
+int main() {
+  PageAllocator<int> allocator;
+
+  auto small = allocator.allocate(100);
+  std::iota(small, small + 100, 0);
+  std::cout << "small sum: "
+            << std::accumulate(small, small + 100, 0) << "\n";
+  allocator.deallocate(small, 100);
+
+  constexpr std::size_t n = 1 << 20;
+  auto large = allocator.allocate(n);
+  std::iota(large, large + n, 0);
+  auto address = reinterpret_cast<std::uintptr_t>(large);
+  std::cout << "large aligned to huge page: " << std::boolalpha
+            << (address % PageAllocator<int>::huge_page == 0)
+            << "\n";
+  std::cout << "large last: " << large[n - 1] << "\n";
+  allocator.deallocate(large, n);
+
+  // Explicit huge pages fall back to regular ones when none
+  // are reserved, and binding to node 0 is best effort.
+  page_options.explicit_huge_pages = true;
+  page_options.numa_node = 0;
+
+  Stack<std::uint64_t> stack;
+  for (std::uint64_t i = 0; i < n; ++i)
+    stack.push(i);
+  std::cout << "stack capacity: " << stack.capacity() << "\n";
+  std::cout << "stack top: " << stack.pop_value() << "\n";
+
+  page_options = {.threshold = 64 << 10};
+
+  // Allocators keep the options they were made with.
+  PageAllocator<int> captured;
+  page_options.threshold = SIZE_MAX;
+  auto kept = captured.allocate(n);
+  address = reinterpret_cast<std::uintptr_t>(kept);
+  std::cout << "captured threshold still maps: "
+            << (address % PageAllocator<int>::huge_page == 0)
+            << "\n";
+  captured.deallocate(kept, n);
+  page_options = {.threshold = 64 << 10};
+
+  Colony<std::uint64_t> colony(1 << 16);
+  for (std::uint64_t i = 0; i < 100000; ++i)
+    colony.insert(i);
+  std::cout << "colony has 99999: "
+            << (colony.search([](auto v) { return v == 99999; })
+                  != nullptr)
+            << "\n";
+}
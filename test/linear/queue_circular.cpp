@@ -1,7 +1,33 @@
 #include "linear/queue_circular.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+
+using contiguous::Queue;
+
+// Counts moves, to check the per-operation bound of
+// incremental migration.
+struct Counted {
+  static inline std::size_t moves = 0;
+
+  int value;
+
+  Counted(int value) : value{value} {}
+  Counted(Counted&& other) noexcept : value{other.value} {
+    ++moves;
+  }
+  auto operator=(Counted&& other) noexcept -> Counted& {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+};
+
+static_assert(noexcept(std::declval<Queue<int>&>().unchecked_dequeue()));
+static_assert(noexcept(std::declval<Queue<int>&>().try_dequeue()));
 
 int main() {
   Queue<std::string> queue;
@@ -20,4 +46,72 @@ int main() {
 
   for (std::size_t i = 0; i < 100; ++i)
     queue.enqueue("very big string, probably will allocate memory...");
+
+  Queue<std::string> incremental({.migration_step = 1});
+
+  for (auto name : {"foo", "bar", "baz", "qux", "quux"}) {
+    incremental.enqueue(name);
+    incremental.enqueue(name);
+    incremental.dequeue();
+  }
+
+  for (; not incremental.is_empty(); incremental.dequeue())
+    std::cout << incremental.front() << "\n";
+
+  for (std::size_t i = 0; i < 100; ++i)
+    incremental.enqueue("very big string, probably will allocate memory...");
+
+  Queue<int> shrinking({.shrink_ratio = 4});
+
+  for (int i = 0; i < 100; ++i)
+    shrinking.enqueue(i);
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  for (int i = 0; i < 90; ++i)
+    shrinking.dequeue();
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  shrinking.shrink_to_fit();
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  std::cout << "contains 95? " << shrinking.contains(95) << "\n";
+  std::cout << "contains 3? " << shrinking.contains(3) << "\n";
+  std::cout << "odd values: " << shrinking.count([](int i) { return i % 2 == 1; }) << "\n";
+  std::cout << "first above 92: " << *shrinking.find([](int i) { return i > 92; }) << "\n";
+
+  std::cout << "dequeued " << shrinking.dequeue_value() << "\n";
+  while (auto value = shrinking.try_dequeue())
+    std::cout << *value << " ";
+  std::cout << "\n";
+
+  try {
+    Queue<int> invalid({.migration_step = 1, .shrink_ratio = 3});
+  } catch (const std::invalid_argument& e) {
+    std::cout << e.what() << "\n";
+  }
+
+  // At most two moves per operation: the argument, plus
+  // one migrated element.
+  Queue<Counted> bounded({.migration_step = 1, .shrink_ratio = 4});
+  std::size_t max_moves = 0;
+  auto measure = [&](auto operation) {
+    Counted::moves = 0;
+    operation();
+    max_moves = std::max(max_moves, Counted::moves);
+  };
+  for (int i = 0; i < 1000; ++i)
+    measure([&] { bounded.enqueue(i); });
+
+  // Refill right after each shrink, so that the halved
+  // buffer fills up as early as possible.
+  for (int round = 0; round < 4; ++round) {
+    auto capacity = bounded.capacity();
+    while (bounded.capacity() == capacity)
+      measure([&] { bounded.dequeue(); });
+
+    capacity = bounded.capacity();
+    while (bounded.capacity() == capacity)
+      measure([&] { bounded.enqueue(0); });
+  }
+  std::cout << "max moves per operation: " << max_moves << "\n";
 }
@@ -0,0 +1,26 @@
+#include "linear/queue_intrusive.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Job {
+  std::string name;
+  Job* next = nullptr;
+};
+
+int main() {
+  Job jobs[] = {{"foo"}, {"bar"}, {"baz"}};
+  IntrusiveQueue<Job, &Job::next> queue;
+
+  for (auto& job : jobs)
+    queue.enqueue(job);
+
+  for (; not queue.is_empty(); queue.dequeue())
+    std::cout << queue.front().name << "\n";
+
+  for (auto& job : jobs)
+    queue.enqueue(job);
+
+  for (; not queue.is_empty(); queue.dequeue())
+    std::cout << queue.front().name << "\n";
+}
@@ -2,6 +2,12 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <utility>
+
+using linked::Queue;
+
+static_assert(noexcept(std::declval<Queue<int>&>().try_dequeue()));
 
 int main() {
   Queue<std::string> queue;
@@ -20,4 +26,20 @@ int main() {
 
   for (std::size_t i = 0; i < 100; ++i)
     queue.enqueue({});
+
+  std::vector<std::byte> buffer;
+  {
+    Queue<int> queue;
+    for (int i = 0; i < 3; ++i)
+      queue.enqueue(i);
+    queue.save([&](std::span<const std::byte> bytes) {
+      buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    });
+  }
+
+  Queue<int> restored;
+  SpanReader reader(buffer);
+  restored.load(reader);
+  for (; not restored.is_empty(); restored.dequeue())
+    std::cout << restored.front() << "\n";
 }
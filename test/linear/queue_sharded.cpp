@@ -0,0 +1,78 @@
+#include "linear/queue_sharded.hpp"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main() {
+  // A single thread always takes from its own shard, in
+  // FIFO order.
+  MultiQueue<int> queue{4};
+  for (auto i = 0; i < 5; ++i)
+    queue.enqueue(i);
+  while (auto value = queue.try_dequeue())
+    std::cout << *value << "\n";
+
+  constexpr auto producers = 4;
+  constexpr auto per_producer = 10000;
+
+  std::vector<std::thread> threads;
+  for (auto p = 0; p < producers; ++p)
+    threads.emplace_back([&queue, p] {
+      for (auto i = 0; i < per_producer; ++i)
+        queue.enqueue(p * per_producer + i);
+    });
+
+  std::vector<int> seen(producers * per_producer);
+  std::vector<std::thread> consumers;
+  for (auto c = 0; c < 2; ++c)
+    consumers.emplace_back([&queue, &seen] {
+      for (auto misses = 0; misses < 1000;)
+        if (auto value = queue.try_dequeue()) {
+          // Each value has a single owner, so no two threads
+          // write the same slot.
+          ++seen[*value];
+          misses = 0;
+        } else {
+          ++misses;
+          std::this_thread::yield();
+        }
+    });
+
+  for (auto& thread : threads)
+    thread.join();
+  for (auto& thread : consumers)
+    thread.join();
+
+  while (auto value = queue.try_dequeue())
+    ++seen[*value];
+
+  auto exactly_once = true;
+  for (auto count : seen)
+    exactly_once = exactly_once and count == 1;
+  std::cout << "every value dequeued once: " << std::boolalpha
+            << exactly_once << "\n";
+
+  std::size_t enqueued = 0, dequeued = 0, size = 0;
+  for (std::size_t i = 0; i < queue.shards(); ++i) {
+    auto stats = queue.statistics(i);
+    enqueued += stats.enqueued;
+    dequeued += stats.dequeued;
+    size += stats.size;
+  }
+  std::cout << enqueued << " enqueued, " << dequeued
+            << " dequeued, " << size << " left\n";
+
+  // An old element on another shard is not starved by a
+  // consumer whose own shard keeps newer ones.
+  MultiQueue<int> pair{2};
+  std::thread{[&pair] { pair.enqueue(-1); }}.join();
+  for (auto i = 0; i < 1000; ++i)
+    pair.enqueue(i);
+
+  auto position = 0;
+  while (*pair.try_dequeue() != -1)
+    ++position;
+  std::cout << "old element taken early: "
+            << (position < 20) << "\n";
+}
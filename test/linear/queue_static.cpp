@@ -0,0 +1,61 @@
+#include "linear/queue_static.hpp"
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+constexpr auto wrapped_front() {
+  StaticQueue<int, 3> queue;
+  for (auto i : {1, 2, 3})
+    (void)queue.enqueue(i);
+
+  queue.dequeue();
+  queue.dequeue();
+
+  if (not queue.enqueue(4) or not queue.enqueue(5))
+    return -1;
+  if (queue.enqueue(6))
+    return -1;
+  return queue.front();
+}
+
+static_assert(wrapped_front() == 3);
+
+// Queues of trivial elements can be static tables.
+constinit StaticQueue<int, 4> empty_table{};
+
+constexpr auto make_table() {
+  StaticQueue<int, 4> queue;
+  for (auto i : {1, 2, 3})
+    (void)queue.enqueue(i);
+  queue.dequeue();
+  return queue;
+}
+
+constexpr auto table = make_table();
+static_assert(table.front() == 2);
+
+static_assert(noexcept(std::declval<StaticQueue<int, 4>&>().try_dequeue()));
+
+int main() {
+  if (empty_table.enqueue(7))
+    std::cout << "table front " << empty_table.front() << "\n";
+
+  StaticQueue<std::string, 3> queue;
+
+  for (auto name : {"foo", "bar", "baz", "qux"})
+    if (not queue.enqueue(name))
+      std::cout << "no room for " << name << "\n";
+
+  for (; not queue.is_empty(); queue.dequeue())
+    std::cout << queue.front() << "\n";
+
+  for (auto name : {"foo", "bar", "baz"})
+    (void)queue.enqueue(name);
+
+  for (; not queue.is_empty(); queue.dequeue())
+    std::cout << queue.front() << "\n";
+
+  for (std::size_t i = 0; i < 3; ++i)
+    (void)queue.enqueue("very big string, probably will allocate memory...");
+}
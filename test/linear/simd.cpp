@@ -0,0 +1,36 @@
+#include "linear/simd.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+template <class T>
+void check(const char* name) {
+  std::vector<T> values;
+  for (std::size_t i = 0; i < 1000; ++i)
+    values.push_back(static_cast<T>(i % 37));
+
+  bool ok = true;
+  for (std::size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000})
+    for (int k : {0, 5, 36, 40}) {
+      auto value = static_cast<T>(k);
+      auto last = values.data() + n;
+      auto expected = std::find(values.data(), last, value);
+
+      ok = ok and find_value(values.data(), n, value) ==
+                    (expected == last ? nullptr : expected);
+      ok = ok and count_value(values.data(), n, value) ==
+                    static_cast<std::size_t>(std::count(values.data(), last, value));
+    }
+
+  std::cout << name << (ok ? " ok" : " MISMATCH") << "\n";
+}
+
+int main() {
+  check<std::int8_t>("int8");
+  check<std::uint16_t>("uint16");
+  check<int>("int32");
+  check<std::int64_t>("int64");
+  check<double>("double");
+}
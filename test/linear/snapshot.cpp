@@ -0,0 +1,201 @@
+#include "linear/snapshot.hpp"
+
+#include "linear/colony.hpp"
+#include "linear/deque.hpp"
+#include "linear/list.hpp"
+#include "linear/queue_circular.hpp"
+#include "linear/stack_contiguous.hpp"
+#include "linear/stack_linked.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using contiguous::Queue;
+using contiguous::Stack;
+
+// Not trivially copyable, so saved through serialize and
+// deserialize, found by ADL.
+struct Entity {
+  int id;
+  std::string name;
+};
+
+void serialize(SnapshotWriter auto& writer,
+               const Entity& entity) {
+  write_element(writer, entity.id);
+  write_element(writer, entity.name);
+}
+
+auto deserialize(SnapshotReader auto& reader,
+                 std::type_identity<Entity>) -> Entity {
+  auto id = read_element<int>(reader);
+  return {id, read_element<std::string>(reader)};
+}
+
+int main() {
+  std::vector<std::byte> buffer;
+  auto writer = [&](std::span<const std::byte> bytes) {
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+  };
+
+  {
+    Stack<int> stack;
+    for (int i = 0; i < 5; ++i)
+      stack.push(i);
+    stack.save(writer);
+
+    Queue<int> queue;
+    for (int i = 0; i < 4; ++i)
+      queue.enqueue(i);
+    queue.dequeue();
+    queue.dequeue();
+    for (int i = 4; i < 6; ++i)
+      queue.enqueue(i);
+    queue.save(writer);
+
+    Deque<int> deque;
+    deque.insert_rear(1);
+    deque.insert_front(0);
+    deque.save(writer);
+
+    List<int> list;
+    list.insert_after(list.before_first(), 7);
+    list.insert_after(list.last(), 8);
+    list.save(writer);
+
+    Colony<int> colony;
+    for (auto i : {10, 11, 12})
+      colony.insert(i);
+    colony.remove(colony.search([](int i) { return i == 11; }));
+    colony.save(writer);
+  }
+
+  auto path = "snapshot.bin";
+  auto file = std::fopen(path, "wb");
+  std::fwrite(buffer.data(), 1, buffer.size(), file);
+  std::fclose(file);
+
+  auto fd = ::open(path, O_RDONLY);
+  struct stat status;
+  ::fstat(fd, &status);
+  auto size = static_cast<std::size_t>(status.st_size);
+  auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  SpanReader reader({static_cast<const std::byte*>(data), size});
+
+  Stack<int> stack;
+  stack.load(reader);
+  std::cout << "stack:";
+  for (; not stack.is_empty(); stack.pop())
+    std::cout << " " << stack.top();
+  std::cout << "\n";
+
+  Queue<int> queue;
+  queue.enqueue(-1);
+  queue.load(reader);
+  std::cout << "queue:";
+  for (; not queue.is_empty(); queue.dequeue())
+    std::cout << " " << queue.front();
+  std::cout << "\n";
+
+  Deque<int> deque;
+  deque.load(reader);
+  std::cout << "deque:";
+  for (; not deque.is_empty(); deque.remove_front())
+    std::cout << " " << deque.front();
+  std::cout << "\n";
+
+  List<int> list;
+  list.load(reader);
+  std::cout << "list:";
+  for (auto p = list.before_first()->next(); p != nullptr; p = p->next())
+    std::cout << " " << p->value();
+  std::cout << "\n";
+
+  Colony<int> colony;
+  colony.load(reader);
+  std::cout << "colony:";
+  colony.search([](int i) { std::cout << " " << i; return false; });
+  std::cout << "\n";
+
+  ::munmap(data, size);
+  std::remove(path);
+
+  // Both stacks save from bottom to top, so either can load
+  // the other's snapshot.
+  buffer.clear();
+  {
+    linked::Stack<int> stack;
+    for (int i = 0; i < 3; ++i)
+      stack.push(i);
+    stack.save(writer);
+  }
+  Stack<int> contiguous;
+  SpanReader linked_reader(buffer);
+  contiguous.load(linked_reader);
+  std::cout << "linked into contiguous:";
+  for (; not contiguous.is_empty(); contiguous.pop())
+    std::cout << " " << contiguous.top();
+  std::cout << "\n";
+
+  try {
+    Stack<long> wider;
+    SpanReader wider_reader(buffer);
+    wider.load(wider_reader);
+  } catch (const std::runtime_error& e) {
+    std::cout << e.what() << "\n";
+  }
+
+  // Overwrite the count, which follows the magic, version
+  // and element size.
+  auto corrupt = buffer;
+  std::uint64_t huge = std::uint64_t{1} << 60;
+  std::memcpy(corrupt.data() + 16, &huge, sizeof(huge));
+  try {
+    Stack<int> stack;
+    SpanReader corrupt_reader(corrupt);
+    stack.load(corrupt_reader);
+  } catch (const std::runtime_error& e) {
+    std::cout << e.what() << "\n";
+  }
+
+  buffer.clear();
+  {
+    Queue<std::string> names;
+    for (auto name : {"foo", "bar", "past the SSO limit"})
+      names.enqueue(name);
+    names.save(writer);
+
+    Colony<Entity> entities;
+    entities.insert({1, "earth"});
+    entities.insert({2, "moon"});
+    entities.save(writer);
+  }
+  SpanReader element_reader(buffer);
+
+  Queue<std::string> names;
+  names.load(element_reader);
+  std::cout << "names:";
+  for (; not names.is_empty(); names.dequeue())
+    std::cout << " " << names.front();
+  std::cout << "\n";
+
+  Colony<Entity> entities;
+  entities.load(element_reader);
+  std::cout << "entities:";
+  entities.search([](const Entity& entity) {
+    std::cout << " " << entity.id << "=" << entity.name;
+    return false;
+  });
+  std::cout << "\n";
+}
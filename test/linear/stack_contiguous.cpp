@@ -1,8 +1,34 @@
 #include "linear/stack_contiguous.hpp"
 
+#include <algorithm>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <iostream>
 
+using contiguous::Stack;
+
+// Counts moves, to check the per-operation bound of
+// incremental migration.
+struct Counted {
+  static inline std::size_t moves = 0;
+
+  int value;
+
+  Counted(int value) : value{value} {}
+  Counted(Counted&& other) noexcept : value{other.value} {
+    ++moves;
+  }
+  auto operator=(Counted&& other) noexcept -> Counted& {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+};
+
+static_assert(noexcept(std::declval<Stack<int>&>().unchecked_pop()));
+static_assert(noexcept(std::declval<Stack<int>&>().try_pop()));
+
 int main() {
   Stack<std::string> stack;
 
@@ -14,4 +40,68 @@ int main() {
 
   for (std::size_t i = 0; i < 100; ++i)
     stack.push({});
+
+  Stack<std::string> incremental({.migration_step = 2});
+
+  for (auto name : {"foo", "bar", "baz", "qux", "quux"})
+    incremental.push(name);
+
+  for (; not incremental.is_empty(); incremental.pop())
+    std::cout << incremental.top() << "\n";
+
+  for (std::size_t i = 0; i < 100; ++i)
+    incremental.push("very big string, probably will allocate memory...");
+
+  Stack<int> shrinking({.shrink_ratio = 4});
+
+  for (int i = 0; i < 100; ++i)
+    shrinking.push(i);
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  for (int i = 0; i < 90; ++i)
+    shrinking.pop();
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  shrinking.shrink_to_fit();
+  std::cout << "capacity " << shrinking.capacity() << "\n";
+
+  std::cout << "contains 3? " << shrinking.contains(3) << "\n";
+  std::cout << "contains 42? " << shrinking.contains(42) << "\n";
+  std::cout << "odd values: " << shrinking.count([](int i) { return i % 2 == 1; }) << "\n";
+
+  std::cout << "popped " << shrinking.pop_value() << "\n";
+  while (auto value = shrinking.try_pop())
+    std::cout << *value << " ";
+  std::cout << "\n";
+
+  try {
+    Stack<int> invalid({.migration_step = 1, .shrink_ratio = 3});
+  } catch (const std::invalid_argument& e) {
+    std::cout << e.what() << "\n";
+  }
+
+  // At most two moves per operation: the argument, plus
+  // one migrated element.
+  Stack<Counted> bounded({.migration_step = 1, .shrink_ratio = 4});
+  std::size_t max_moves = 0;
+  auto measure = [&](auto operation) {
+    Counted::moves = 0;
+    operation();
+    max_moves = std::max(max_moves, Counted::moves);
+  };
+  for (int i = 0; i < 1000; ++i)
+    measure([&] { bounded.push(i); });
+
+  // Refill right after each shrink, so that the halved
+  // buffer fills up as early as possible.
+  for (int round = 0; round < 4; ++round) {
+    auto capacity = bounded.capacity();
+    while (bounded.capacity() == capacity)
+      measure([&] { bounded.pop(); });
+
+    capacity = bounded.capacity();
+    while (bounded.capacity() == capacity)
+      measure([&] { bounded.push(0); });
+  }
+  std::cout << "max moves per operation: " << max_moves << "\n";
 }
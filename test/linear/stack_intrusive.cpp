@@ -0,0 +1,26 @@
+#include "linear/stack_intrusive.hpp"
+
+#include <string>
+#include <iostream>
+
+struct Frame {
+  std::string name;
+  Frame* next = nullptr;
+};
+
+int main() {
+  Frame frames[] = {{"foo"}, {"bar"}, {"baz"}};
+  IntrusiveStack<Frame, &Frame::next> stack;
+
+  for (auto& frame : frames)
+    stack.push(frame);
+
+  for (; not stack.is_empty(); stack.pop())
+    std::cout << stack.top().name << "\n";
+
+  for (auto& frame : frames)
+    stack.push(frame);
+
+  while (auto frame = stack.try_pop())
+    std::cout << frame->name << "\n";
+}
@@ -1,7 +1,13 @@
 #include "linear/stack_linked.hpp"
 
 #include <iostream>
+#include <vector>
 #include <string>
+#include <utility>
+
+using linked::Stack;
+
+static_assert(noexcept(std::declval<Stack<int>&>().try_pop()));
 
 int main() {
   Stack<std::string> stack;
@@ -14,4 +20,20 @@ int main() {
 
   for (std::size_t i = 0; i < 100; ++i)
     stack.push({});
+
+  std::vector<std::byte> buffer;
+  {
+    Stack<int> stack;
+    for (int i = 0; i < 3; ++i)
+      stack.push(i);
+    stack.save([&](std::span<const std::byte> bytes) {
+      buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    });
+  }
+
+  Stack<int> restored;
+  SpanReader reader(buffer);
+  restored.load(reader);
+  for (; not restored.is_empty(); restored.pop())
+    std::cout << restored.top() << "\n";
 }
@@ -0,0 +1,72 @@
+#include "linear/stack_static.hpp"
+
+#include <string>
+#include <iostream>
+#include <utility>
+
+constexpr auto overflowing_push() {
+  StaticStack<int, 4> stack;
+  for (auto i : {1, 2, 3, 4, 5})
+    if (not stack.push(i))
+      return -1;
+  return 0;
+}
+
+constexpr auto sum_of_pops() {
+  StaticStack<int, 4> stack;
+  for (auto i : {1, 2, 3, 4})
+    (void)stack.push(i);
+
+  int sum = 0;
+  for (; not stack.is_empty(); stack.pop())
+    sum += stack.top();
+  return sum;
+}
+
+static_assert(overflowing_push() == -1);
+static_assert(sum_of_pops() == 10);
+
+constexpr auto popped_values() {
+  StaticStack<int, 4> stack;
+  (void)stack.push(1);
+  (void)stack.push(2);
+
+  auto top = stack.pop_value();
+  auto next = stack.try_pop();
+  return top * 10 + *next + (stack.try_pop() ? 100 : 0);
+}
+
+static_assert(popped_values() == 21);
+
+// Stacks of trivial elements can be static tables.
+constinit StaticStack<int, 4> empty_table{};
+
+constexpr auto make_table() {
+  StaticStack<int, 4> stack;
+  for (auto i : {1, 2, 3})
+    (void)stack.push(i);
+  stack.pop();
+  return stack;
+}
+
+constexpr auto table = make_table();
+static_assert(table.top() == 2);
+
+static_assert(noexcept(std::declval<StaticStack<int, 4>&>().try_pop()));
+
+int main() {
+  if (empty_table.push(7))
+    std::cout << "table top " << empty_table.top() << "\n";
+
+  StaticStack<std::string, 3> stack;
+
+  for (auto name : {"foo", "bar", "baz", "qux"})
+    if (not stack.push(name))
+      std::cout << "no room for " << name << "\n";
+
+  for (; not stack.is_empty(); stack.pop())
+    std::cout << stack.top() << "\n";
+
+  for (std::size_t i = 0; i < 3; ++i)
+    (void)stack.push("very big string, probably will allocate memory...");
+}
@@ -0,0 +1,107 @@
+#include "linear/trace.hpp"
+
+#include "linear/deque.hpp"
+#include "linear/queue_circular.hpp"
+#include "linear/stack_contiguous.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <queue>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using contiguous::Queue;
+using contiguous::Stack;
+
+int main() {
+  Recorded<Stack<std::string>> stack;
+  for (auto name : {"foo", "quux", "a much longer name"})
+    stack.push(std::string{name});
+  stack.pop();
+  std::cout << stack.top() << "\n";
+  (void)stack.try_pop();
+  (void)stack.try_pop();
+  (void)stack.try_pop();
+
+  std::cout << stack.trace().size() << " operations in "
+            << stack.trace().bytes() << " bytes\n";
+
+  std::vector<std::byte> buffer;
+  stack.trace().save([&](std::span<const std::byte> bytes) {
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+  });
+
+  Trace loaded;
+  loaded.load(SpanReader{buffer});
+
+  std::stack<std::string> replayed;
+  loaded.for_each([&](Trace::Event event) {
+    apply(replayed, event, [](std::size_t n) {
+      return std::string(n, 'x');
+    });
+    if (not replayed.empty())
+      std::cout << replayed.top() << " ";
+  });
+  std::cout << "\n";
+
+  Recorded<Queue<int>> queue;
+  for (int i = 0; i < 1000; ++i) {
+    queue.enqueue(i);
+    if (i % 3 == 0)
+      queue.dequeue();
+  }
+
+  std::queue<int> fifo;
+  int next = 0;
+  replay(queue.trace(), fifo,
+         [&](std::size_t) { return next++; });
+  std::cout << fifo.size() << " left, front " << fifo.front()
+            << "\n";
+
+  Recorded<Deque<int>> deque;
+  for (int i = 0; i < 6; ++i) {
+    if (i % 2 == 0)
+      deque.insert_front(i);
+    else
+      deque.insert_rear(i);
+  }
+  deque.remove_front();
+  (void)deque.try_remove_rear();
+  std::cout << deque.front() << " " << deque.rear() << "\n";
+
+  std::deque<int> both;
+  next = 0;
+  replay(deque.trace(), both,
+         [&](std::size_t) { return next++; });
+  std::cout << both.size() << " left, front "
+            << both.front() << ", rear " << both.back()
+            << "\n";
+
+  // Traces read from files are checked before decoding.
+  auto load_raw = [](std::size_t size,
+                     std::vector<std::uint8_t> bytes) {
+    std::vector<std::byte> raw;
+    auto writer = [&](std::span<const std::byte> b) {
+      raw.insert(raw.end(), b.begin(), b.end());
+    };
+    write_header<std::uint8_t>(writer, bytes.size());
+    write_values(writer, &size, 1);
+    write_values(writer, bytes.data(), bytes.size());
+
+    Trace trace;
+    try {
+      trace.load(SpanReader{raw});
+      std::cout << "loaded " << trace.size() << "\n";
+    } catch (const std::runtime_error& e) {
+      std::cout << e.what() << "\n";
+    }
+  };
+  load_raw(2, {0x90, 0x01, 0x01});
+  load_raw(1, std::vector<std::uint8_t>(11, 0x80));
+  load_raw(1, {0x90});
+  load_raw(1, {0x0F});
+  load_raw(3, {0x01});
+}
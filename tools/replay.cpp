@@ -0,0 +1,242 @@
+// Replays a recorded Trace against every stack, queue or
+// deque implementation of the library and of the standard
+// library, and reports time, allocations, peak memory and
+// per-operation latency percentiles for each.
+//
+//   tools/replay.exe trace.bin
+//
+// Inserted elements are strings of the recorded size, so
+// their allocations count the same for every container.
+//
+// Allocations are counted by a replaced operator new, which
+// PageAllocator bypasses when it maps large buffers. The
+// tool turns mapping off, so that every buffer is counted
+// and the library containers compare fairly with std::.
+
+#include "linear/deque.hpp"
+#include "linear/page_allocator.hpp"
+#include "linear/queue_circular.hpp"
+#include "linear/queue_linked.hpp"
+#include "linear/snapshot.hpp"
+#include "linear/stack_contiguous.hpp"
+#include "linear/stack_linked.hpp"
+#include "linear/trace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <new>
+#include <optional>
+#include <queue>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Allocations {
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  std::size_t live = 0;
+  std::size_t peak = 0;
+};
+
+Allocations allocations;
+
+} // namespace
+
+// Each block carries its size in a header, so that freeing
+// it can update the live byte count.
+void* operator new(std::size_t n) {
+  auto block = static_cast<std::max_align_t*>(
+    std::malloc(sizeof(std::max_align_t) + n));
+  if (block == nullptr)
+    throw std::bad_alloc{};
+  *reinterpret_cast<std::size_t*>(block) = n;
+
+  ++allocations.count;
+  allocations.bytes += n;
+  allocations.live += n;
+  allocations.peak =
+    std::max(allocations.peak, allocations.live);
+  return block + 1;
+}
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr)
+    return;
+  auto block = static_cast<std::max_align_t*>(p) - 1;
+  allocations.live -=
+    *reinterpret_cast<std::size_t*>(block);
+  std::free(block);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  operator delete(p);
+}
+
+template <class T>
+struct DequeStack : Deque<T> {
+  void push(T value) {
+    this->insert_rear(std::move(value));
+  }
+  void pop() { this->remove_rear(); }
+  auto top() const -> const T& { return this->rear(); }
+};
+
+template <class T>
+struct DequeQueue : Deque<T> {
+  void enqueue(T value) {
+    this->insert_rear(std::move(value));
+  }
+  void dequeue() { this->remove_front(); }
+};
+
+template <class C>
+void run(const char* name, const Trace& trace) {
+  using Clock = std::chrono::steady_clock;
+  auto make = [](std::size_t n) {
+    return std::string(n, 'x');
+  };
+
+  std::vector<std::int64_t> latencies;
+  latencies.reserve(trace.size());
+
+  auto before = allocations;
+  allocations.peak = allocations.live;
+
+  Clock::duration total{};
+  {
+    C container;
+    trace.for_each([&](Trace::Event event) {
+      auto start = Clock::now();
+      apply(container, event, make);
+      auto elapsed = Clock::now() - start;
+
+      total += elapsed;
+      latencies.push_back(
+        std::chrono::nanoseconds{elapsed}.count());
+    });
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) -> std::int64_t {
+    if (latencies.empty())
+      return 0;
+    auto i = static_cast<std::size_t>(
+      p * static_cast<double>(latencies.size() - 1));
+    return latencies[i];
+  };
+
+  using Milliseconds =
+    std::chrono::duration<double, std::milli>;
+  std::printf(
+    "%-22s %10.3f %10zu %12zu %12zu %8lld %8lld %8lld\n",
+    name, Milliseconds{total}.count(),
+    allocations.count - before.count,
+    allocations.bytes - before.bytes,
+    allocations.peak - before.live,
+    static_cast<long long>(percentile(0.5)),
+    static_cast<long long>(percentile(0.99)),
+    static_cast<long long>(percentile(0.999)));
+}
+
+void header(const char* title) {
+  std::printf("\n%-22s %10s %10s %12s %12s %8s %8s %8s\n",
+              title, "ms", "allocs", "bytes", "peak bytes",
+              "p50 ns", "p99 ns", "p999 ns");
+}
+
+auto read_file(const char* path) -> std::vector<std::byte> {
+  std::ifstream file{path, std::ios::binary};
+  if (not file)
+    throw std::runtime_error{"cannot open trace file"};
+
+  std::vector<char> chars{
+    std::istreambuf_iterator<char>{file},
+    std::istreambuf_iterator<char>{}};
+  std::vector<std::byte> bytes(chars.size());
+  std::memcpy(bytes.data(), chars.data(), chars.size());
+  return bytes;
+}
+
+void replay_all(const Trace& trace) {
+
+  // Deques share the front peek with queues, so any deque
+  // operation makes the whole trace a deque trace.
+  bool lifo = false, fifo = false, both_ends = false;
+  trace.for_each([&](Trace::Event event) {
+    if (event.op <= Trace::Op::top)
+      lifo = true;
+    else if (event.op <= Trace::Op::front)
+      fifo = true;
+    else
+      both_ends = true;
+  });
+  if (both_ends)
+    lifo = fifo = false;
+
+  std::printf("%zu operations, %zu bytes of trace\n",
+              trace.size(), trace.bytes());
+
+  using S = std::string;
+
+  if (lifo) {
+    header("stack");
+    run<contiguous::Stack<S>>("Stack (contiguous)", trace);
+    run<linked::Stack<S>>("Stack (linked)", trace);
+    run<DequeStack<S>>("Deque", trace);
+    run<std::stack<S>>("std::stack<deque>", trace);
+    run<std::stack<S, std::vector<S>>>("std::stack<vector>",
+                                       trace);
+    run<std::stack<S, std::list<S>>>("std::stack<list>",
+                                     trace);
+  }
+
+  if (fifo) {
+    header("queue");
+    run<contiguous::Queue<S>>("Queue (circular)", trace);
+    run<linked::Queue<S>>("Queue (linked)", trace);
+    run<DequeQueue<S>>("Deque", trace);
+    run<std::queue<S>>("std::queue<deque>", trace);
+    run<std::queue<S, std::list<S>>>("std::queue<list>",
+                                     trace);
+  }
+
+  if (both_ends) {
+    header("deque");
+    run<Deque<S>>("Deque", trace);
+    run<std::deque<S>>("std::deque", trace);
+    run<std::list<S>>("std::list", trace);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::fprintf(stderr, "usage: %s TRACE\n", argv[0]);
+    return 1;
+  }
+
+  page_options.threshold = SIZE_MAX;
+
+  try {
+    Trace trace;
+    auto bytes = read_file(argv[1]);
+    trace.load(SpanReader{bytes});
+    replay_all(trace);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s: %s\n", argv[1], e.what());
+    return 1;
+  }
+}